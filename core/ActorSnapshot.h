@@ -0,0 +1,224 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <string_view>
+#include <vector>
+
+#include "PluginIndexTable.h"
+#include "ProximityKernel.h"
+
+// Loaded actors copied out of the game once per monitoring tick, stored column-wise so
+// proximity and identity queries scan a few tight arrays instead of re-walking the
+// process lists and dereferencing every actor handle again.
+//
+// The snapshot is built with the radii the plugin cares about; End() classifies every actor
+// against all of them in one ComputeProximityBands() sweep. That sweep is skipped while
+// neither the player nor any actor moved further than the tolerance since the last one.
+class ActorSnapshot {
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    explicit ActorSnapshot(std::initializer_list<float> radii = {}, float moveTolerance = 16.0f)
+        : _moveToleranceSquared(moveTolerance * moveTolerance) {
+        for (float radius : radii) {
+            if (_radiusCount < kProximityBands) {
+                _radii[_radiusCount] = radius;
+                _limits.squared[_radiusCount] = radius * radius;
+                _radiusCount++;
+            }
+        }
+    }
+
+    // Hash of a display name, trimmed like NormalizeName() so keys match the scene table.
+    static std::uint64_t NameKey(std::string_view name) {
+        constexpr std::string_view whitespace = " \t\r\n";
+        std::size_t first = name.find_first_not_of(whitespace);
+        if (first == std::string_view::npos) {
+            return std::hash<std::string_view>{}({});
+        }
+        return std::hash<std::string_view>{}(name.substr(first, name.find_last_not_of(whitespace) - first + 1));
+    }
+
+    void Clear() {
+        _refIDs.clear();
+        _baseIDs.clear();
+        _x.clear();
+        _y.clear();
+        _z.clear();
+        _nameKeys.clear();
+        _masks.clear();
+        _anchorRefIDs.clear();
+        _anchorX.clear();
+        _anchorY.clear();
+        _anchorZ.clear();
+        _revision++;
+    }
+
+    void Reserve(std::size_t count) {
+        _refIDs.reserve(count);
+        _baseIDs.reserve(count);
+        _x.reserve(count);
+        _y.reserve(count);
+        _z.reserve(count);
+        _nameKeys.reserve(count);
+    }
+
+    // Starts a new capture around origin, normally the player's position.
+    void Begin(float originX, float originY, float originZ) {
+        _refIDs.clear();
+        _baseIDs.clear();
+        _x.clear();
+        _y.clear();
+        _z.clear();
+        _nameKeys.clear();
+
+        _originX = originX;
+        _originY = originY;
+        _originZ = originZ;
+        _moved = Moved(originX - _anchorOriginX, originY - _anchorOriginY, originZ - _anchorOriginZ);
+    }
+
+    void Add(std::uint32_t refID, std::uint32_t baseID, float x, float y, float z, std::uint64_t nameKey) {
+        std::size_t row = _refIDs.size();
+        if (!_moved) {
+            _moved = row >= _anchorRefIDs.size() || _anchorRefIDs[row] != refID ||
+                     Moved(x - _anchorX[row], y - _anchorY[row], z - _anchorZ[row]);
+        }
+
+        _refIDs.push_back(refID);
+        _baseIDs.push_back(baseID);
+        _x.push_back(x);
+        _y.push_back(y);
+        _z.push_back(z);
+        _nameKeys.push_back(nameKey);
+    }
+
+    // Finishes the capture; false when the previous band masks were still good.
+    bool End() {
+        if (!_moved && _refIDs.size() == _anchorRefIDs.size()) {
+            return false;
+        }
+
+        std::size_t count = _refIDs.size();
+        _masks.resize(count);
+        ComputeProximityBands(_x.data(), _y.data(), _z.data(), count, _originX, _originY, _originZ, _limits,
+                              _masks.data());
+
+        _anchorRefIDs = _refIDs;
+        _anchorX = _x;
+        _anchorY = _y;
+        _anchorZ = _z;
+        _anchorOriginX = _originX;
+        _anchorOriginY = _originY;
+        _anchorOriginZ = _originZ;
+        _revision++;
+        return true;
+    }
+
+    // Changes whenever the band masks were recomputed or the snapshot was cleared.
+    std::uint64_t Revision() const { return _revision; }
+
+    std::size_t Size() const { return _refIDs.size(); }
+    bool Empty() const { return _refIDs.empty(); }
+
+    std::uint32_t RefID(std::size_t i) const { return _refIDs[i]; }
+    std::uint32_t BaseID(std::size_t i) const { return _baseIDs[i]; }
+    std::uint64_t NameKeyAt(std::size_t i) const { return _nameKeys[i]; }
+    float X(std::size_t i) const { return _x[i]; }
+    float Y(std::size_t i) const { return _y[i]; }
+    float Z(std::size_t i) const { return _z[i]; }
+
+    float DistanceSquared(std::size_t i) const {
+        float dx = _x[i] - _originX;
+        float dy = _y[i] - _originY;
+        float dz = _z[i] - _originZ;
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    // Uses the precomputed band for one of the configured radii, the exact distance otherwise.
+    bool Within(std::size_t i, float radius) const {
+        std::size_t band = BandFor(radius);
+        return band != npos ? (_masks[i] >> band) & 1 : DistanceSquared(i) <= radius * radius;
+    }
+
+    // Each query returns the first matching actor within the radius, or npos.
+    std::size_t FindInPlugin(const PluginIndex& plugin, float radius) const {
+        return FindWithin(radius, [&](std::size_t i) { return plugin.Contains(_baseIDs[i]); });
+    }
+
+    std::size_t FindByBaseID(std::uint32_t baseID, float radius) const {
+        return FindWithin(radius, [&](std::size_t i) { return _baseIDs[i] == baseID; });
+    }
+
+    std::size_t FindByRefID(std::uint32_t refID, float radius) const {
+        return FindWithin(radius, [&](std::size_t i) { return _refIDs[i] == refID; });
+    }
+
+    std::size_t FindByNameKey(std::uint64_t nameKey, float radius) const {
+        return FindWithin(radius, [&](std::size_t i) { return _nameKeys[i] == nameKey; });
+    }
+
+    template <class Fn>
+    void ForEachWithin(float radius, Fn&& fn) const {
+        for (std::size_t i = 0; i < _refIDs.size(); i++) {
+            if (Within(i, radius)) {
+                fn(i);
+            }
+        }
+    }
+
+private:
+    std::size_t BandFor(float radius) const {
+        for (std::size_t k = 0; k < _radiusCount; k++) {
+            if (_radii[k] == radius) {
+                return _masks.size() == _refIDs.size() ? k : npos;
+            }
+        }
+        return npos;
+    }
+
+    bool Moved(float dx, float dy, float dz) const {
+        return dx * dx + dy * dy + dz * dz > _moveToleranceSquared;
+    }
+
+    template <class Matches>
+    std::size_t FindWithin(float radius, Matches&& matches) const {
+        for (std::size_t i = 0; i < _refIDs.size(); i++) {
+            if (matches(i) && Within(i, radius)) {
+                return i;
+            }
+        }
+        return npos;
+    }
+
+    std::array<float, kProximityBands> _radii{};
+    ProximityLimits _limits;
+    std::size_t _radiusCount = 0;
+    float _moveToleranceSquared;
+
+    std::vector<std::uint32_t> _refIDs;
+    std::vector<std::uint32_t> _baseIDs;
+    std::vector<float> _x;
+    std::vector<float> _y;
+    std::vector<float> _z;
+    std::vector<std::uint64_t> _nameKeys;
+    std::vector<std::uint8_t> _masks;
+    float _originX = 0.0f;
+    float _originY = 0.0f;
+    float _originZ = 0.0f;
+
+    // Positions the current masks were computed from.
+    std::vector<std::uint32_t> _anchorRefIDs;
+    std::vector<float> _anchorX;
+    std::vector<float> _anchorY;
+    std::vector<float> _anchorZ;
+    float _anchorOriginX = 0.0f;
+    float _anchorOriginY = 0.0f;
+    float _anchorOriginZ = 0.0f;
+    bool _moved = true;
+    std::uint64_t _revision = 0;
+};
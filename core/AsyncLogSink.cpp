@@ -0,0 +1,249 @@
+#include "AsyncLogSink.h"
+
+#include "TimestampFormatter.h"
+
+#ifdef _WIN32
+#include <share.h>
+#endif
+
+namespace {
+    constexpr std::size_t kSegmentLines = 2000;
+
+    void FormatTimestamp(std::chrono::system_clock::time_point time, std::string& out) {
+        char text[TimestampFormatter::kMillisLength];
+        std::size_t length = TimestampFormatter::GetSingleton().FormatMillis(time, text);
+        out += '[';
+        out.append(text, length);
+        out += "] ";
+    }
+
+    std::FILE* OpenLogFile(const std::filesystem::path& path) {
+#ifdef _WIN32
+        return _wfsopen(path.c_str(), L"wb", _SH_DENYNO);
+#else
+        return std::fopen(path.c_str(), "wb");
+#endif
+    }
+}
+
+AsyncLogSink::~AsyncLogSink() {
+    Stop();
+}
+
+void AsyncLogSink::SetFile(std::size_t index, std::filesystem::path path, std::string tag) {
+    if (index >= kMaxFiles || IsRunning()) {
+        return;
+    }
+    File& file = _files[index];
+    file.previousPath = path;
+    file.previousPath.replace_extension(".1" + path.extension().string());
+    file.path = std::move(path);
+    file.tag = std::move(tag);
+    file.configured = true;
+}
+
+void AsyncLogSink::Start() {
+    if (IsRunning()) {
+        return;
+    }
+
+    for (auto& file : _files) {
+        if (file.configured) {
+            ResetSegments(file);
+        }
+    }
+
+    _stopping.store(false);
+    _running.store(true, std::memory_order_release);
+    _writer = std::thread(&AsyncLogSink::WriterThread, this);
+}
+
+void AsyncLogSink::Stop() {
+    if (!IsRunning()) {
+        return;
+    }
+
+    _stopping.store(true);
+    Wake();
+    if (_writer.joinable()) {
+        _writer.join();
+    }
+    _running.store(false, std::memory_order_release);
+
+    for (auto& file : _files) {
+        if (file.handle) {
+            std::fclose(file.handle);
+            file.handle = nullptr;
+        }
+    }
+}
+
+void AsyncLogSink::Truncate() {
+    Record record;
+    record.truncate = true;
+    Push(std::move(record));
+}
+
+void AsyncLogSink::Write(std::size_t index, int lineNumber, std::string message) {
+    if (index >= kMaxFiles) {
+        return;
+    }
+
+    Record record;
+    record.file = static_cast<std::uint8_t>(index);
+    record.lineNumber = lineNumber;
+    record.time = std::chrono::system_clock::now();
+    record.message = std::move(message);
+    Push(std::move(record));
+}
+
+void AsyncLogSink::Push(Record&& record) {
+    while (!_queue.TryPush(std::move(record))) {
+        // Only a stalled or absent writer lets the queue fill up; before Start() there
+        // is nobody to make room, so the record is dropped instead of blocking the game.
+        if (!IsRunning()) {
+            return;
+        }
+        Wake();
+        std::this_thread::yield();
+    }
+
+    // Pairs with the fence in WriterThread so a record published just after the writer's
+    // last drain always sees it marked idle and wakes it.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_idle.load(std::memory_order_relaxed) && _idle.exchange(false)) {
+        Wake();
+    }
+}
+
+void AsyncLogSink::Wake() {
+    _wake.fetch_add(1);
+    _wake.notify_one();
+}
+
+void AsyncLogSink::WriterThread() {
+    for (;;) {
+        if (DrainQueue()) {
+            FlushBatches();
+            continue;
+        }
+
+        // Take the ticket before testing _stopping: a Stop() landing in between then
+        // bumps the ticket past it and the wait below returns instead of sleeping forever.
+        std::uint32_t ticket = _wake.load();
+        if (_stopping.load()) {
+            break;
+        }
+
+        _idle.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (DrainQueue()) {
+            _idle.store(false, std::memory_order_relaxed);
+            FlushBatches();
+            continue;
+        }
+
+        _wake.wait(ticket);
+        _idle.store(false, std::memory_order_relaxed);
+        if (_stopping.load()) {
+            continue;
+        }
+
+        // Give a burst of lines (actor banners, scene start) a moment to arrive so it
+        // lands in one write instead of one write per line.
+        std::this_thread::sleep_for(kBatchWindow);
+    }
+
+    DrainQueue();
+    FlushBatches();
+}
+
+bool AsyncLogSink::DrainQueue() {
+    bool drained = false;
+    Record record;
+
+    while (_queue.TryPop(record)) {
+        drained = true;
+
+        if (record.truncate) {
+            for (auto& file : _files) {
+                if (file.configured) {
+                    file.batch.clear();
+                    ResetSegments(file);
+                }
+            }
+            continue;
+        }
+
+        File& file = _files[record.file];
+        if (file.configured) {
+            Append(file, record);
+        }
+    }
+
+    return drained;
+}
+
+void AsyncLogSink::Append(File& file, const Record& record) {
+    if (file.segmentLines >= kSegmentLines) {
+        Rotate(file);
+    }
+
+    std::string& out = file.batch;
+    FormatTimestamp(record.time, out);
+    out += file.tag;
+    out += " [";
+    out += _sourceName;
+    out += ':';
+    out += std::to_string(record.lineNumber);
+    out += "] ";
+    out += record.message;
+    out += '\n';
+    file.segmentLines++;
+}
+
+void AsyncLogSink::FlushBatches() {
+    for (auto& file : _files) {
+        if (file.batch.empty()) {
+            continue;
+        }
+        if (file.handle) {
+            std::fwrite(file.batch.data(), 1, file.batch.size(), file.handle);
+            std::fflush(file.handle);
+        }
+        file.batch.clear();
+    }
+}
+
+// The full segment becomes "<name>.1.log", replacing the one before it, and writing
+// continues in a fresh file, so rotation costs one rename instead of a rewrite.
+void AsyncLogSink::Rotate(File& file) {
+    if (file.handle) {
+        if (!file.batch.empty()) {
+            std::fwrite(file.batch.data(), 1, file.batch.size(), file.handle);
+        }
+        std::fclose(file.handle);
+        file.handle = nullptr;
+    }
+    file.batch.clear();
+
+    std::error_code ec;
+    std::filesystem::rename(file.path, file.previousPath, ec);
+    Reopen(file);
+    file.segmentLines = 0;
+}
+
+void AsyncLogSink::ResetSegments(File& file) {
+    std::error_code ec;
+    std::filesystem::remove(file.previousPath, ec);
+    Reopen(file);
+    file.segmentLines = 0;
+}
+
+void AsyncLogSink::Reopen(File& file) {
+    if (file.handle) {
+        std::fclose(file.handle);
+    }
+    file.handle = OpenLogFile(file.path);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+#include "MpscQueue.h"
+
+// Background writer for the plugin's own log files. Producers just push a record onto a
+// lock-free queue; one writer thread formats, batches and appends the lines through a
+// handle per file that stays open for the whole session. Each log is bounded to two
+// segments: the live file and the previous one, kept as "<name>.1.log".
+class AsyncLogSink {
+public:
+    static constexpr std::size_t kMaxFiles = 4;
+    static constexpr std::size_t kQueueCapacity = 4096;
+    static constexpr std::chrono::milliseconds kBatchWindow{5};
+
+    static AsyncLogSink& GetSingleton() {
+        static AsyncLogSink singleton;
+        return singleton;
+    }
+
+    ~AsyncLogSink();
+
+    // Files must be configured before Start(); the tag is written after the timestamp,
+    // e.g. "[log] [info]".
+    void SetFile(std::size_t index, std::filesystem::path path, std::string tag);
+    void SetSourceName(std::string sourceName) { _sourceName = std::move(sourceName); }
+
+    // Opens every configured file truncated and starts the writer thread.
+    void Start();
+    // Writes out everything queued so far, closes the files and joins the writer.
+    void Stop();
+    // Truncates every file and drops its previous segment once all records queued before
+    // this call have been written.
+    void Truncate();
+
+    bool IsRunning() const { return _running.load(std::memory_order_acquire); }
+
+    void Write(std::size_t index, int lineNumber, std::string message);
+
+private:
+    struct Record {
+        std::uint8_t file = 0;
+        bool truncate = false;
+        int lineNumber = 0;
+        std::chrono::system_clock::time_point time;
+        std::string message;
+    };
+
+    struct File {
+        std::filesystem::path path;
+        std::filesystem::path previousPath;
+        std::string tag;
+        std::FILE* handle = nullptr;
+        std::string batch;
+        std::size_t segmentLines = 0;
+        bool configured = false;
+    };
+
+    AsyncLogSink() = default;
+    AsyncLogSink(const AsyncLogSink&) = delete;
+    AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+    void Push(Record&& record);
+    void Wake();
+    void WriterThread();
+    bool DrainQueue();
+    void Append(File& file, const Record& record);
+    void FlushBatches();
+    void Rotate(File& file);
+    void ResetSegments(File& file);
+    void Reopen(File& file);
+
+    MpscQueue<Record, kQueueCapacity> _queue;
+    std::array<File, kMaxFiles> _files;
+    std::string _sourceName = "plugin.cpp";
+    std::thread _writer;
+    std::atomic<bool> _running{false};
+    std::atomic<bool> _stopping{false};
+    std::atomic<bool> _idle{false};
+    std::atomic<std::uint32_t> _wake{0};
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <vector>
+
+// Immutable configuration published through an atomic pointer. Readers take the current
+// snapshot with a single acquire load and never see a half-parsed file; a reload builds a
+// new object and swaps it in. Replaced snapshots stay alive as long as the holder does, so
+// a reference returned by Get() never dangles; reloads only happen when the user edits the
+// INI, which keeps that history tiny.
+template <class Config>
+class ConfigSnapshot {
+public:
+    ConfigSnapshot() { Publish(Config{}); }
+
+    ConfigSnapshot(const ConfigSnapshot&) = delete;
+    ConfigSnapshot& operator=(const ConfigSnapshot&) = delete;
+
+    const Config& Get() const { return *_current.load(std::memory_order_acquire); }
+
+    void Publish(Config config) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _snapshots.push_back(std::make_unique<const Config>(std::move(config)));
+        _current.store(_snapshots.back().get(), std::memory_order_release);
+    }
+
+    // True when the file's size or write time differ from the previous call, i.e. when
+    // the snapshot needs to be rebuilt from it. Costs one stat, never reads the file.
+    bool HasChanged(const std::filesystem::path& path) {
+        FileStamp stamp;
+        std::error_code ec;
+        stamp.size = std::filesystem::file_size(path, ec);
+        stamp.exists = !ec;
+        if (stamp.exists) {
+            stamp.writeTime = std::filesystem::last_write_time(path, ec);
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_stampValid && stamp == _stamp) {
+            return false;
+        }
+        _stamp = stamp;
+        _stampValid = true;
+        return true;
+    }
+
+    // Forces the next HasChanged() to report a change, e.g. after a failed parse.
+    void Invalidate() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stampValid = false;
+    }
+
+private:
+    struct FileStamp {
+        bool exists = false;
+        std::uintmax_t size = 0;
+        std::filesystem::file_time_type writeTime{};
+
+        bool operator==(const FileStamp&) const = default;
+    };
+
+    std::atomic<const Config*> _current{nullptr};
+    std::mutex _mutex;
+    std::vector<std::unique_ptr<const Config>> _snapshots;
+    FileStamp _stamp;
+    bool _stampValid = false;
+};
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Runs periodic tasks on one thread, each at the deadline it asks for. A task returns the
+// time it next wants to run (or kNever to stay parked until woken); Run() keeps the
+// deadlines in a min-heap and sleeps until the earliest one or until another thread calls
+// Wake()/WakeAll(), so an idle set of tasks costs no wakeups at all. Tasks that are due
+// together run in registration order.
+class DeadlineScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+    using Task = std::function<TimePoint(TimePoint now)>;
+
+    static constexpr TimePoint kNever = TimePoint::max();
+
+    // Registration happens before Run(); the returned id is used for Wake().
+    std::size_t Add(std::string_view name, Task task, TimePoint firstDeadline) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::size_t id = _tasks.size();
+        _tasks.push_back({std::string(name), std::move(task), kNever, 0});
+        Schedule(id, firstDeadline);
+        return id;
+    }
+
+    // Makes a task due now. Safe from any thread, including from inside a running task.
+    void Wake(std::size_t id) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (id < _tasks.size()) {
+                Schedule(id, Clock::now());
+            }
+        }
+        _wake.notify_one();
+    }
+
+    void WakeAll() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            TimePoint now = Clock::now();
+            for (std::size_t id = 0; id < _tasks.size(); id++) {
+                Schedule(id, now);
+            }
+        }
+        _wake.notify_one();
+    }
+
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopped = true;
+        }
+        _wake.notify_one();
+    }
+
+    // Runs on the scheduler thread after the tasks that were due together have run, before it
+    // sleeps again; e.g. to hand off what those tasks produced as one batch.
+    void SetIdleHook(std::function<void()> hook) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _idleHook = std::move(hook);
+    }
+
+    // Clears a previous Stop() and drops every task and the idle hook, for a fresh registration.
+    void Reset() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.clear();
+        _idleHook = nullptr;
+        _heap = {};
+        _stopped = false;
+        _wakeups = 0;
+        _runs = 0;
+    }
+
+    // Returns after Stop().
+    void Run() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        bool ranTasks = false;
+        while (!_stopped) {
+            while (!_heap.empty() && IsStale(_heap.top())) {
+                _heap.pop();
+            }
+
+            TimePoint now = Clock::now();
+            TimePoint next = _heap.empty() ? kNever : _heap.top().deadline;
+            if (next > now && ranTasks && _idleHook) {
+                ranTasks = false;
+                std::function<void()> hook = _idleHook;
+                lock.unlock();
+                hook();
+                lock.lock();
+                continue;
+            }
+            if (next > now) {
+                ranTasks = false;
+                _signalled = false;
+                auto woken = [this] { return _stopped || _signalled; };
+                if (next == kNever) {
+                    _wake.wait(lock, woken);
+                } else {
+                    _wake.wait_until(lock, next, woken);
+                }
+                _wakeups++;
+                continue;
+            }
+
+            std::size_t id = _heap.top().task;
+            _heap.pop();
+            _tasks[id].deadline = kNever;
+            _tasks[id].generation++;
+            Task task = _tasks[id].task;
+
+            lock.unlock();
+            TimePoint requested = task(now);
+            lock.lock();
+            _runs++;
+            ranTasks = true;
+
+            // Schedule() only ever moves a deadline earlier, so a Wake() that arrived while
+            // the task ran is kept.
+            if (id < _tasks.size()) {
+                Schedule(id, requested);
+            }
+        }
+    }
+
+    std::uint64_t Wakeups() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _wakeups;
+    }
+
+    std::uint64_t Runs() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _runs;
+    }
+
+private:
+    struct TaskEntry {
+        std::string name;
+        Task task;
+        TimePoint deadline;
+        std::uint64_t generation;
+    };
+
+    struct HeapEntry {
+        TimePoint deadline;
+        std::size_t task;
+        std::uint64_t generation;
+
+        // std::priority_queue is a max-heap; invert so the earliest deadline, then the
+        // earliest registered task, is on top.
+        bool operator<(const HeapEntry& other) const {
+            return deadline != other.deadline ? deadline > other.deadline : task > other.task;
+        }
+    };
+
+    bool IsStale(const HeapEntry& entry) const { return _tasks[entry.task].generation != entry.generation; }
+
+    // Moves a task to a new deadline; its old heap entry becomes stale and is skipped.
+    void Schedule(std::size_t id, TimePoint deadline) {
+        TaskEntry& entry = _tasks[id];
+        if (entry.deadline != kNever && entry.deadline <= deadline) {
+            return;
+        }
+        entry.deadline = deadline;
+        entry.generation++;
+        if (deadline != kNever) {
+            _heap.push({deadline, id, entry.generation});
+        }
+        _signalled = true;
+    }
+
+    mutable std::mutex _mutex;
+    std::condition_variable _wake;
+    std::vector<TaskEntry> _tasks;
+    std::priority_queue<HeapEntry> _heap;
+    std::function<void()> _idleHook;
+    bool _stopped = false;
+    bool _signalled = false;
+    std::uint64_t _wakeups = 0;
+    std::uint64_t _runs = 0;
+};
@@ -0,0 +1,363 @@
+#include "DirectoryWatcher.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+DirectoryWatcher::~DirectoryWatcher() {
+    Close();
+#ifdef _WIN32
+    if (_stopEvent) {
+        CloseHandle(static_cast<HANDLE>(_stopEvent));
+    }
+#else
+    if (_stopFd >= 0) {
+        ::close(_stopFd);
+    }
+#endif
+}
+
+bool DirectoryWatcher::Start(const std::vector<fs::path>& directories, fs::path fileName,
+                             std::chrono::milliseconds coalesceWindow) {
+    Close();
+    _fileName = std::move(fileName);
+    _coalesceWindow = coalesceWindow;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::error_code ec;
+        for (const auto& directory : directories) {
+            if (fs::is_directory(directory, ec) &&
+                std::find(_directories.begin(), _directories.end(), directory) == _directories.end()) {
+                _directories.push_back(directory);
+            }
+        }
+        _stats = {};
+    }
+
+    if (!OpenPlatform()) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void DirectoryWatcher::Close() {
+    ClosePlatform();
+    std::lock_guard<std::mutex> lock(_mutex);
+    _directories.clear();
+}
+
+DirectoryWatcher::Result DirectoryWatcher::Wait(std::chrono::milliseconds timeout) {
+    Drain first = WaitOnce(timeout);
+    switch (first) {
+        case Drain::kNothing:
+            return Result::kTimeout;
+        case Drain::kStopped:
+            return Result::kStopped;
+        case Drain::kError:
+            return Result::kError;
+        case Drain::kMatched:
+            break;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + _coalesceWindow;
+    for (auto now = std::chrono::steady_clock::now(); now < deadline; now = std::chrono::steady_clock::now()) {
+        auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - now);
+        Drain more = WaitOnce(remaining);
+        if (more == Drain::kStopped) {
+            return Result::kStopped;
+        }
+        if (more == Drain::kError) {
+            break;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats.signals++;
+    return Result::kChanged;
+}
+
+bool DirectoryWatcher::IsWatching(const fs::path& directory) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return std::find(_directories.begin(), _directories.end(), directory) != _directories.end();
+}
+
+DirectoryWatcher::Stats DirectoryWatcher::GetStats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+#ifdef _WIN32
+
+struct DirectoryWatcher::Watch {
+    fs::path path;
+    HANDLE directory = INVALID_HANDLE_VALUE;
+    OVERLAPPED overlapped{};
+    bool pending = false;
+    // ReadDirectoryChangesW wants DWORD-aligned records.
+    std::unique_ptr<DWORD[]> buffer{new DWORD[kBufferSize / sizeof(DWORD)]};
+
+    bool Arm() {
+        ResetEvent(overlapped.hEvent);
+        pending = ReadDirectoryChangesW(directory, buffer.get(), static_cast<DWORD>(kBufferSize), FALSE,
+                                        FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE |
+                                            FILE_NOTIFY_CHANGE_FILE_NAME,
+                                        nullptr, &overlapped, nullptr);
+        return pending;
+    }
+
+    void Release() {
+        if (pending) {
+            CancelIoEx(directory, &overlapped);
+            DWORD ignored = 0;
+            GetOverlappedResult(directory, &overlapped, &ignored, TRUE);
+            pending = false;
+        }
+        if (overlapped.hEvent) {
+            CloseHandle(overlapped.hEvent);
+        }
+        CloseHandle(directory);
+    }
+};
+
+DirectoryWatcher::DirectoryWatcher() {
+    _stopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+}
+
+void DirectoryWatcher::Stop() {
+    if (_stopEvent) {
+        SetEvent(static_cast<HANDLE>(_stopEvent));
+    }
+}
+
+bool DirectoryWatcher::OpenPlatform() {
+    if (!_stopEvent) {
+        return false;
+    }
+    ResetEvent(static_cast<HANDLE>(_stopEvent));
+
+    std::vector<fs::path> directories;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        directories = _directories;
+    }
+
+    std::vector<fs::path> watched;
+    for (const auto& path : directories) {
+        auto watch = std::make_unique<Watch>();
+        watch->path = path;
+        watch->directory = CreateFileW(path.wstring().c_str(), FILE_LIST_DIRECTORY,
+                                       FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                                       FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+        if (watch->directory == INVALID_HANDLE_VALUE) {
+            continue;
+        }
+        watch->overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        if (!watch->overlapped.hEvent || !watch->Arm()) {
+            watch->Release();
+            continue;
+        }
+        _watches.push_back(std::move(watch));
+        watched.push_back(path);
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _directories = std::move(watched);
+    return !_watches.empty();
+}
+
+void DirectoryWatcher::ClosePlatform() {
+    for (auto& watch : _watches) {
+        watch->Release();
+    }
+    _watches.clear();
+}
+
+DirectoryWatcher::Drain DirectoryWatcher::WaitOnce(std::chrono::milliseconds timeout) {
+    std::vector<HANDLE> handles;
+    handles.reserve(_watches.size() + 1);
+    handles.push_back(static_cast<HANDLE>(_stopEvent));
+    for (const auto& watch : _watches) {
+        handles.push_back(watch->overlapped.hEvent);
+    }
+
+    DWORD waitMs = timeout.count() < 0 ? INFINITE : static_cast<DWORD>(timeout.count());
+    DWORD signalled = WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE, waitMs);
+    if (signalled == WAIT_TIMEOUT) {
+        return Drain::kNothing;
+    }
+    if (signalled == WAIT_OBJECT_0) {
+        return Drain::kStopped;
+    }
+    if (signalled < WAIT_OBJECT_0 + 1 || signalled >= WAIT_OBJECT_0 + handles.size()) {
+        return Drain::kError;
+    }
+
+    // Several directories can complete together; collect all of them before re-arming. An
+    // overflowed read fails with ERROR_NOTIFY_ENUM_DIR (or completes empty) and counts as a
+    // change. A directory whose read fails otherwise, or cannot be re-armed, is dropped, and
+    // the rest stay watched; that also counts as a change, since a write may have been missed.
+    bool matched = false;
+    std::uint64_t records = 0;
+    std::uint64_t overflows = 0;
+    std::vector<fs::path> dropped;
+    for (auto it = _watches.begin(); it != _watches.end();) {
+        Watch& watch = **it;
+        if (WaitForSingleObject(watch.overlapped.hEvent, 0) != WAIT_OBJECT_0) {
+            ++it;
+            continue;
+        }
+
+        DWORD bytes = 0;
+        watch.pending = false;
+        bool completed = GetOverlappedResult(watch.directory, &watch.overlapped, &bytes, FALSE);
+        bool overflowed = completed ? bytes == 0 : GetLastError() == ERROR_NOTIFY_ENUM_DIR;
+
+        if (overflowed) {
+            overflows++;
+            matched = true;
+        } else if (completed) {
+            auto* record = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(watch.buffer.get());
+            while (true) {
+                records++;
+                std::wstring_view name(record->FileName, record->FileNameLength / sizeof(wchar_t));
+                if (name == _fileName.native()) {
+                    matched = true;
+                }
+                if (record->NextEntryOffset == 0) {
+                    break;
+                }
+                record = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(
+                    reinterpret_cast<const BYTE*>(record) + record->NextEntryOffset);
+            }
+        }
+
+        if ((completed || overflowed) && watch.Arm()) {
+            ++it;
+            continue;
+        }
+        matched = true;
+        dropped.push_back(watch.path);
+        watch.Release();
+        it = _watches.erase(it);
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const auto& path : dropped) {
+        _directories.erase(std::remove(_directories.begin(), _directories.end(), path), _directories.end());
+    }
+    _stats.records += records;
+    _stats.overflows += overflows;
+    return matched ? Drain::kMatched : Drain::kNothing;
+}
+
+#else
+
+DirectoryWatcher::DirectoryWatcher() {
+    _stopFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+}
+
+void DirectoryWatcher::Stop() {
+    if (_stopFd >= 0) {
+        std::uint64_t one = 1;
+        [[maybe_unused]] auto written = ::write(_stopFd, &one, sizeof(one));
+    }
+}
+
+bool DirectoryWatcher::OpenPlatform() {
+    if (_stopFd < 0) {
+        return false;
+    }
+    std::uint64_t drained = 0;
+    while (::read(_stopFd, &drained, sizeof(drained)) > 0) {
+    }
+
+    _inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_inotify < 0) {
+        return false;
+    }
+    _buffer.resize(kBufferSize);
+
+    std::vector<fs::path> directories;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        directories = _directories;
+    }
+
+    std::vector<fs::path> watched;
+    for (const auto& path : directories) {
+        int descriptor = inotify_add_watch(_inotify, path.c_str(),
+                                           IN_MODIFY | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO);
+        if (descriptor >= 0) {
+            _watchDescriptors.push_back(descriptor);
+            watched.push_back(path);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _directories = std::move(watched);
+    return !_watchDescriptors.empty();
+}
+
+void DirectoryWatcher::ClosePlatform() {
+    if (_inotify >= 0) {
+        ::close(_inotify);
+        _inotify = -1;
+    }
+    _watchDescriptors.clear();
+}
+
+DirectoryWatcher::Drain DirectoryWatcher::WaitOnce(std::chrono::milliseconds timeout) {
+    pollfd fds[2] = {{_stopFd, POLLIN, 0}, {_inotify, POLLIN, 0}};
+    int ready = ::poll(fds, 2, timeout.count() < 0 ? -1 : static_cast<int>(timeout.count()));
+    if (ready == 0) {
+        return Drain::kNothing;
+    }
+    if (ready < 0) {
+        return errno == EINTR ? Drain::kNothing : Drain::kError;
+    }
+    if (fds[0].revents & POLLIN) {
+        return Drain::kStopped;
+    }
+
+    bool matched = false;
+    std::uint64_t records = 0;
+    std::uint64_t overflows = 0;
+    while (true) {
+        ssize_t length = ::read(_inotify, _buffer.data(), _buffer.size());
+        if (length <= 0) {
+            break;
+        }
+        for (ssize_t offset = 0; offset < length;) {
+            inotify_event event;
+            std::memcpy(&event, _buffer.data() + offset, sizeof(event));
+            records++;
+            if (event.mask & IN_Q_OVERFLOW) {
+                overflows++;
+                matched = true;
+            } else if (event.len > 0 && _fileName.native() == _buffer.data() + offset + sizeof(inotify_event)) {
+                matched = true;
+            }
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event.len);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stats.records += records;
+    _stats.overflows += overflows;
+    return matched ? Drain::kMatched : Drain::kNothing;
+}
+
+#endif
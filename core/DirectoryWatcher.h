@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Waits for changes to one file name in several directories at once, e.g. OStim.log in both
+// SKSE log folders. Every directory has a read outstanding the whole time (overlapped
+// ReadDirectoryChangesW on Windows, one inotify instance elsewhere), and a burst of
+// notifications is folded into a single kChanged: after the first matching record the
+// watcher keeps draining for the coalesce window before it reports.
+class DirectoryWatcher {
+public:
+    enum class Result {
+        kChanged,
+        kTimeout,
+        kStopped,
+        kError
+    };
+
+    struct Stats {
+        std::uint64_t signals = 0;
+        std::uint64_t records = 0;
+        std::uint64_t overflows = 0;
+    };
+
+    static constexpr std::size_t kBufferSize = 64 * 1024;
+    static constexpr std::chrono::milliseconds kDefaultCoalesceWindow{50};
+    static constexpr std::chrono::milliseconds kInfinite{-1};
+
+    DirectoryWatcher();
+    ~DirectoryWatcher();
+    DirectoryWatcher(const DirectoryWatcher&) = delete;
+    DirectoryWatcher& operator=(const DirectoryWatcher&) = delete;
+
+    // Watches every directory in the list that exists. False when none could be watched.
+    bool Start(const std::vector<std::filesystem::path>& directories, std::filesystem::path fileName,
+               std::chrono::milliseconds coalesceWindow = kDefaultCoalesceWindow);
+    void Close();
+
+    // Blocks until the file changed in any watched directory, Stop() is called or the
+    // timeout (kInfinite for none) passes. A buffer overflow counts as a change, and so does a
+    // directory whose watch failed; that directory is no longer watched (see IsWatching()).
+    // With nothing watched it still honours Stop() and the timeout, so callers can fall back
+    // to polling. kError means waiting itself failed.
+    Result Wait(std::chrono::milliseconds timeout = kInfinite);
+
+    // Wakes a pending Wait() with kStopped, and every later one until Start() again. Safe
+    // from any thread.
+    void Stop();
+
+    // Safe from any thread.
+    bool IsWatching(const std::filesystem::path& directory) const;
+    Stats GetStats() const;
+
+private:
+    enum class Drain {
+        kNothing,
+        kMatched,
+        kStopped,
+        kError
+    };
+
+    // Waits up to timeout for the next batch of records; kMatched when one of them named the
+    // file (or the batch overflowed).
+    Drain WaitOnce(std::chrono::milliseconds timeout);
+    bool OpenPlatform();
+    void ClosePlatform();
+
+    std::filesystem::path _fileName;
+    std::chrono::milliseconds _coalesceWindow = kDefaultCoalesceWindow;
+
+    mutable std::mutex _mutex;
+    std::vector<std::filesystem::path> _directories;
+    Stats _stats;
+
+#ifdef _WIN32
+    struct Watch;
+    std::vector<std::unique_ptr<Watch>> _watches;
+    void* _stopEvent = nullptr;
+#else
+    int _inotify = -1;
+    int _stopFd = -1;
+    std::vector<int> _watchDescriptors;
+    std::vector<char> _buffer;
+#endif
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Game-state changes produced by the background threads (inventory additions, actor-value
+// restores, global reductions and HUD notifications), collected here and applied together by a
+// single task on the main thread. Recording merges what can be merged: counts for the same
+// item, amounts for the same actor value and reductions of the same global add up, and an
+// identical notification is shown once per batch.
+template <class Item, class Global, class ActorValue>
+class EffectQueue {
+public:
+    struct ItemEffect {
+        Item* item;
+        int count;
+    };
+
+    struct RestoreEffect {
+        ActorValue actorValue;
+        float amount;
+    };
+
+    struct GlobalEffect {
+        Global* global;
+        float amount;
+    };
+
+    struct Batch {
+        std::vector<ItemEffect> items;
+        std::vector<RestoreEffect> restores;
+        std::vector<GlobalEffect> globals;
+        std::vector<std::string> notifications;
+
+        bool Empty() const { return Size() == 0; }
+        std::size_t Size() const { return items.size() + restores.size() + globals.size() + notifications.size(); }
+    };
+
+    struct Stats {
+        std::uint64_t flushes = 0;
+        std::uint64_t effects = 0;
+        std::chrono::nanoseconds total{};
+        std::chrono::nanoseconds longest{};
+    };
+
+    void AddItem(Item* item, int count) {
+        if (!item || count <= 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = std::find_if(_pending.items.begin(), _pending.items.end(),
+                               [item](const ItemEffect& effect) { return effect.item == item; });
+        if (it != _pending.items.end()) {
+            it->count += count;
+        } else {
+            _pending.items.push_back({item, count});
+        }
+    }
+
+    void RestoreActorValue(ActorValue actorValue, float amount) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = std::find_if(_pending.restores.begin(), _pending.restores.end(),
+                               [actorValue](const RestoreEffect& effect) { return effect.actorValue == actorValue; });
+        if (it != _pending.restores.end()) {
+            it->amount += amount;
+        } else {
+            _pending.restores.push_back({actorValue, amount});
+        }
+    }
+
+    // Recorded as a delta rather than a value: the global only changes once the batch is
+    // applied, so two reductions read from the same stale value must still both land.
+    void ReduceGlobal(Global* global, float amount) {
+        if (!global || amount == 0.0f) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = std::find_if(_pending.globals.begin(), _pending.globals.end(),
+                               [global](const GlobalEffect& effect) { return effect.global == global; });
+        if (it != _pending.globals.end()) {
+            it->amount += amount;
+        } else {
+            _pending.globals.push_back({global, amount});
+        }
+    }
+
+    void Notify(std::string text) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (std::find(_pending.notifications.begin(), _pending.notifications.end(), text) ==
+            _pending.notifications.end()) {
+            _pending.notifications.push_back(std::move(text));
+        }
+    }
+
+    // Hands over everything recorded so far and starts an empty batch.
+    Batch Take() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return std::exchange(_pending, Batch{});
+    }
+
+    void Clear() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pending = Batch{};
+    }
+
+    // Called by whoever applied a batch, with how long applying it took.
+    void RecordFlush(std::size_t effects, std::chrono::nanoseconds elapsed) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stats.flushes++;
+        _stats.effects += effects;
+        _stats.total += elapsed;
+        _stats.longest = std::max(_stats.longest, elapsed);
+    }
+
+    Stats GetStats() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _stats;
+    }
+
+private:
+    mutable std::mutex _mutex;
+    Batch _pending;
+    Stats _stats;
+};
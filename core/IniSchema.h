@@ -0,0 +1,293 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Compile-time description of an INI file: one row per key, in file order, mapping
+// [Section] Key to a member of the config struct. The same table drives reading,
+// writing the defaults and rewriting the file, so the layout only exists once.
+
+enum class IniValueType : std::uint8_t {
+    kBool,
+    kInt,
+    kString
+};
+
+struct IniValue {
+    IniValueType type;
+    void* target;
+};
+
+inline IniValue IniRef(bool& value) { return {IniValueType::kBool, &value}; }
+inline IniValue IniRef(int& value) { return {IniValueType::kInt, &value}; }
+inline IniValue IniRef(std::string& value) { return {IniValueType::kString, &value}; }
+
+template <class Config>
+struct IniField {
+    std::string_view section;
+    std::string_view key;
+    IniValue (*access)(Config& config);
+};
+
+// FNV-1a over "section", a separator and "key"; the section state is computed once per
+// [Section] header and only the key is hashed per line.
+constexpr std::uint64_t kIniHashBasis = 14695981039346656037ull;
+
+constexpr std::uint64_t IniHash(std::string_view text, std::uint64_t state = kIniHashBasis) {
+    for (char c : text) {
+        state = (state ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    return state;
+}
+
+constexpr std::uint64_t IniHashSection(std::string_view section) {
+    return IniHash("]", IniHash(section));
+}
+
+constexpr std::uint64_t IniHashKey(std::uint64_t sectionState, std::string_view key) {
+    return IniHash(key, sectionState);
+}
+
+template <class Config, std::size_t N>
+struct IniSchema {
+    struct IndexEntry {
+        std::uint64_t hash;
+        std::uint32_t field;
+    };
+
+    std::array<IniField<Config>, N> fields;
+    std::array<IndexEntry, N> index;
+
+    // Binary search over the sorted hashes; strings are only compared to confirm a hit.
+    const IniField<Config>* Find(std::uint64_t hash, std::string_view section, std::string_view key) const {
+        auto it = std::lower_bound(index.begin(), index.end(), hash,
+                                   [](const IndexEntry& entry, std::uint64_t value) { return entry.hash < value; });
+        if (it == index.end() || it->hash != hash) {
+            return nullptr;
+        }
+        const IniField<Config>& field = fields[it->field];
+        return field.section == section && field.key == key ? &field : nullptr;
+    }
+};
+
+template <class Config, std::size_t N>
+consteval IniSchema<Config, N> MakeIniSchema(const IniField<Config> (&fields)[N]) {
+    IniSchema<Config, N> schema{};
+    for (std::size_t i = 0; i < N; i++) {
+        schema.fields[i] = fields[i];
+        schema.index[i] = {IniHashKey(IniHashSection(fields[i].section), fields[i].key), static_cast<std::uint32_t>(i)};
+    }
+
+    std::sort(schema.index.begin(), schema.index.end(),
+              [](const auto& a, const auto& b) { return a.hash < b.hash; });
+
+    for (std::size_t i = 1; i < N; i++) {
+        if (schema.index[i].hash == schema.index[i - 1].hash) {
+            throw "duplicate or colliding INI key in schema";
+        }
+    }
+    return schema;
+}
+
+inline std::string_view TrimIniText(std::string_view text) {
+    constexpr std::string_view whitespace = " \t\r\n";
+    std::size_t first = text.find_first_not_of(whitespace);
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    return text.substr(first, text.find_last_not_of(whitespace) - first + 1);
+}
+
+inline void AssignIniValue(IniValue value, std::string_view text) {
+    switch (value.type) {
+        case IniValueType::kBool:
+            *static_cast<bool*>(value.target) = text == "1" || text == "true" || text == "True";
+            break;
+
+        case IniValueType::kInt: {
+            if (!text.empty() && text.front() == '+') {
+                text.remove_prefix(1);
+            }
+            // Malformed numbers keep the default instead of throwing like std::stoi did.
+            int parsed = 0;
+            auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), parsed);
+            if (ec == std::errc() && ptr != text.data()) {
+                *static_cast<int*>(value.target) = parsed;
+            }
+            break;
+        }
+
+        case IniValueType::kString:
+            static_cast<std::string*>(value.target)->assign(text);
+            break;
+    }
+}
+
+// Calls onSection(name) for every [Section] header and onValue(section, key, value) for every
+// key=value line, with comments and blank lines skipped and everything trimmed.
+template <class OnSection, class OnValue>
+void ScanIniText(std::string_view text, OnSection&& onSection, OnValue&& onValue) {
+    std::string_view section;
+
+    while (!text.empty()) {
+        std::size_t end = text.find('\n');
+        std::string_view line = TrimIniText(text.substr(0, end));
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+
+        if (line.empty() || line.front() == ';' || line.front() == '#') {
+            continue;
+        }
+
+        if (line.front() == '[' && line.back() == ']') {
+            section = line.substr(1, line.size() - 2);
+            onSection(section);
+            continue;
+        }
+
+        std::size_t equalPos = line.find('=');
+        if (equalPos == std::string_view::npos) {
+            continue;
+        }
+
+        onValue(section, TrimIniText(line.substr(0, equalPos)), TrimIniText(line.substr(equalPos + 1)));
+    }
+}
+
+// Applies every known key found in the text to config; anything else is ignored.
+template <class Config, std::size_t N>
+void ParseIniText(std::string_view text, const IniSchema<Config, N>& schema, Config& config) {
+    std::uint64_t sectionState = IniHashSection({});
+
+    ScanIniText(
+        text, [&](std::string_view section) { sectionState = IniHashSection(section); },
+        [&](std::string_view section, std::string_view key, std::string_view value) {
+            const IniField<Config>* field = schema.Find(IniHashKey(sectionState, key), section, key);
+            if (field) {
+                AssignIniValue(field->access(config), value);
+            }
+        });
+}
+
+// Repeated sections such as [Reward.Ale] and [Reward.Milk]: for every section named prefix
+// plus a suffix, onSection(suffix) returns the Config to fill (or nullptr to skip it), and the
+// section's keys are applied through a schema whose rows have an empty section name.
+template <class Config, std::size_t N, class OnSection>
+void ParseIniSections(std::string_view text, std::string_view prefix, const IniSchema<Config, N>& schema,
+                      OnSection&& onSection) {
+    const std::uint64_t sectionState = IniHashSection({});
+    Config* current = nullptr;
+
+    ScanIniText(
+        text,
+        [&](std::string_view section) {
+            bool matches = section.size() > prefix.size() && section.substr(0, prefix.size()) == prefix;
+            current = matches ? onSection(section.substr(prefix.size())) : nullptr;
+        },
+        [&](std::string_view, std::string_view key, std::string_view value) {
+            if (!current) {
+                return;
+            }
+            const IniField<Config>* field = schema.Find(IniHashKey(sectionState, key), {}, key);
+            if (field) {
+                AssignIniValue(field->access(*current), value);
+            }
+        });
+}
+
+inline bool ReadIniText(const std::filesystem::path& path, std::string& text) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+template <class Config, std::size_t N>
+bool ReadIniFile(const std::filesystem::path& path, const IniSchema<Config, N>& schema, Config& config) {
+    std::string text;
+    if (!ReadIniText(path, text)) {
+        return false;
+    }
+    ParseIniText(text, schema, config);
+    return true;
+}
+
+inline void AppendIniValue(std::string& text, std::string_view key, IniValue value) {
+    text += key;
+    text += '=';
+
+    switch (value.type) {
+        case IniValueType::kBool:
+            text += *static_cast<bool*>(value.target) ? "true" : "false";
+            break;
+        case IniValueType::kInt:
+            text += std::to_string(*static_cast<int*>(value.target));
+            break;
+        case IniValueType::kString:
+            text += *static_cast<std::string*>(value.target);
+            break;
+    }
+    text += '\n';
+}
+
+// Takes the config by value because the field accessors hand out mutable references.
+template <class Config, std::size_t N>
+std::string FormatIniText(const IniSchema<Config, N>& schema, Config config) {
+    std::string text;
+    std::string_view section;
+
+    for (const auto& field : schema.fields) {
+        if (field.section != section) {
+            if (!text.empty()) {
+                text += '\n';
+            }
+            section = field.section;
+            text += '[';
+            text += section;
+            text += "]\n";
+        }
+
+        AppendIniValue(text, field.key, field.access(config));
+    }
+
+    return text;
+}
+
+// Writes one repeated section (see ParseIniSections) under the given name.
+template <class Config, std::size_t N>
+void AppendIniSection(std::string& text, std::string_view section, const IniSchema<Config, N>& schema, Config config) {
+    if (!text.empty()) {
+        text += '\n';
+    }
+    text += '[';
+    text += section;
+    text += "]\n";
+
+    for (const auto& field : schema.fields) {
+        AppendIniValue(text, field.key, field.access(config));
+    }
+}
+
+inline bool WriteIniText(const std::filesystem::path& path, const std::string& text) {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << text;
+    return static_cast<bool>(file);
+}
+
+template <class Config, std::size_t N>
+bool WriteIniFile(const std::filesystem::path& path, const IniSchema<Config, N>& schema, const Config& config) {
+    return WriteIniText(path, FormatIniText(schema, config));
+}
@@ -0,0 +1,118 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+MappedFile::~MappedFile() {
+    Close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const fs::path& path) {
+    Close();
+
+    HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    _file = file;
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size)) {
+        Close();
+        return false;
+    }
+    _size = static_cast<std::uint64_t>(size.QuadPart);
+    _open = true;
+    if (_size == 0) {
+        return true;
+    }
+
+    // Map exactly the size seen above; the writer may keep appending behind it.
+    _mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, static_cast<DWORD>(_size >> 32),
+                                  static_cast<DWORD>(_size & 0xFFFFFFFF), nullptr);
+    if (!_mapping) {
+        Close();
+        return false;
+    }
+    _data = static_cast<const char*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, static_cast<SIZE_T>(_size)));
+    if (!_data) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void MappedFile::Close() {
+    if (_data) {
+        UnmapViewOfFile(_data);
+        _data = nullptr;
+    }
+    if (_mapping) {
+        CloseHandle(static_cast<HANDLE>(_mapping));
+        _mapping = nullptr;
+    }
+    if (_file != INVALID_HANDLE_VALUE) {
+        CloseHandle(static_cast<HANDLE>(_file));
+        _file = INVALID_HANDLE_VALUE;
+    }
+    _size = 0;
+    _open = false;
+}
+
+#else
+
+bool MappedFile::Open(const fs::path& path) {
+    Close();
+
+    _fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (_fd < 0) {
+        return false;
+    }
+
+    struct stat info {};
+    if (fstat(_fd, &info) != 0) {
+        Close();
+        return false;
+    }
+    _size = static_cast<std::uint64_t>(info.st_size);
+    _open = true;
+    if (_size == 0) {
+        return true;
+    }
+
+    void* data = ::mmap(nullptr, static_cast<std::size_t>(_size), PROT_READ, MAP_PRIVATE, _fd, 0);
+    if (data == MAP_FAILED) {
+        Close();
+        return false;
+    }
+    ::madvise(data, static_cast<std::size_t>(_size), MADV_SEQUENTIAL);
+    _data = static_cast<const char*>(data);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (_data) {
+        ::munmap(const_cast<char*>(_data), static_cast<std::size_t>(_size));
+        _data = nullptr;
+    }
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+    _size = 0;
+    _open = false;
+}
+
+#endif
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+// A whole file mapped read-only, for reading a large OStim.log in one pass without copying
+// it. The view covers the file as it was when opened; bytes appended later are not in it.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // An empty file opens with an empty view.
+    bool Open(const std::filesystem::path& path);
+    void Close();
+
+    bool IsOpen() const { return _open; }
+    std::string_view View() const { return {_data, static_cast<std::size_t>(_size)}; }
+
+private:
+    const char* _data = nullptr;
+    std::uint64_t _size = 0;
+    bool _open = false;
+#ifdef _WIN32
+    void* _file = reinterpret_cast<void*>(-1);
+    void* _mapping = nullptr;
+#else
+    int _fd = -1;
+#endif
+};
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Bounded lock-free queue for many producers and one consumer (Vyukov's array queue).
+// Each cell carries a sequence number that tells producers whether it is free and the
+// consumer whether it has been published, so neither side ever takes a lock.
+template <class T, std::size_t Capacity>
+class MpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    MpscQueue() : _cells(std::make_unique<Cell[]>(Capacity)) {
+        for (std::size_t i = 0; i < Capacity; i++) {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    bool TryPush(T&& value) {
+        Cell* cell = nullptr;
+        std::size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+
+        for (;;) {
+            cell = &_cells[pos & kMask];
+            std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+
+            if (diff == 0) {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side only.
+    bool TryPop(T& value) {
+        Cell& cell = _cells[_dequeuePos & kMask];
+        std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(_dequeuePos + 1) < 0) {
+            return false;
+        }
+
+        value = std::move(cell.value);
+        cell.sequence.store(_dequeuePos + Capacity, std::memory_order_release);
+        _dequeuePos++;
+        return true;
+    }
+
+private:
+    static constexpr std::size_t kMask = Capacity - 1;
+
+    struct Cell {
+        std::atomic<std::size_t> sequence{0};
+        T value{};
+    };
+
+    std::unique_ptr<Cell[]> _cells;
+    alignas(64) std::atomic<std::size_t> _enqueuePos{0};
+    alignas(64) std::size_t _dequeuePos = 0;
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <string_view>
+
+enum NeedSlot : std::size_t {
+    kHungerNeed,
+    kColdNeed,
+    kExhaustionNeed,
+    kNeedSlotCount
+};
+
+struct NeedValues {
+    std::array<float, kNeedSlotCount> value{};
+    std::array<bool, kNeedSlotCount> present{};
+
+    bool AllAtOrBelow(float limit) const {
+        for (std::size_t slot = 0; slot < kNeedSlotCount; slot++) {
+            if (present[slot] && value[slot] > limit) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool AnyAbove(float limit) const { return !AllAtOrBelow(limit); }
+};
+
+using NeedAmounts = std::array<float, kNeedSlotCount>;
+
+// The need globals one survival mod exposes, e.g. Survival Mode's Survival_*NeedValue or
+// Frostfall's exposure. Editor IDs are looked up once per data load through Resolve(); every
+// later read or reduction goes through the cached pointers, and a reduction writes all slots
+// in one pass from a single read. Global is any type with a float `value` member, which is
+// what RE::TESGlobal provides.
+template <class Global>
+class NeedsProvider {
+public:
+    using EditorIDs = std::array<std::string_view, kNeedSlotCount>;
+
+    NeedsProvider(std::string_view name, EditorIDs editorIDs) : _name(name), _editorIDs(editorIDs) {}
+
+    std::string_view Name() const { return _name; }
+
+    // lookup(editorID) returns a Global* or nullptr. Slots without an editor ID stay unused.
+    // True when every named slot was found.
+    template <class Lookup>
+    bool Resolve(Lookup&& lookup) {
+        bool complete = true;
+        for (std::size_t slot = 0; slot < kNeedSlotCount; slot++) {
+            Global* global = _editorIDs[slot].empty() ? nullptr : lookup(_editorIDs[slot]);
+            complete = complete && (_editorIDs[slot].empty() || global);
+            _globals[slot].store(global, std::memory_order_release);
+        }
+        _resolved.store(complete, std::memory_order_release);
+        return complete;
+    }
+
+    void Reset() {
+        _resolved.store(false, std::memory_order_release);
+        for (auto& global : _globals) {
+            global.store(nullptr, std::memory_order_release);
+        }
+    }
+
+    bool IsResolved() const { return _resolved.load(std::memory_order_acquire); }
+
+    NeedValues Read() const {
+        NeedValues values;
+        for (std::size_t slot = 0; slot < kNeedSlotCount; slot++) {
+            if (Global* global = _globals[slot].load(std::memory_order_acquire)) {
+                values.value[slot] = global->value;
+                values.present[slot] = true;
+            }
+        }
+        return values;
+    }
+
+    // Lowers every slot of current by the matching amount, clamped at zero, and returns the
+    // results. The change itself goes through write(global, amount), which lowers the global
+    // by amount at whatever value it has by then, so queued reductions stack.
+    template <class Write>
+    NeedValues Reduce(const NeedValues& current, const NeedAmounts& amounts, Write&& write) {
+        NeedValues reduced = current;
+        for (std::size_t slot = 0; slot < kNeedSlotCount; slot++) {
+            Global* global = _globals[slot].load(std::memory_order_acquire);
+            if (!global || !current.present[slot]) {
+                reduced.present[slot] = false;
+                continue;
+            }
+            reduced.value[slot] = std::max(0.0f, current.value[slot] - amounts[slot]);
+            write(global, amounts[slot]);
+        }
+        return reduced;
+    }
+
+    NeedValues Reduce(const NeedValues& current, const NeedAmounts& amounts) {
+        return Reduce(current, amounts,
+                      [](Global* global, float amount) { global->value = std::max(0.0f, global->value - amount); });
+    }
+
+private:
+    std::string_view _name;
+    EditorIDs _editorIDs;
+    std::array<std::atomic<Global*>, kNeedSlotCount> _globals{};
+    std::atomic<bool> _resolved{false};
+};
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <string>
+#include <string_view>
+
+#include "OStimLineClassifier.h"
+
+enum class OStimEventKind : std::uint8_t {
+    kNone,
+    kSceneEnd,
+    kNodeChange,
+    kSpeedChange,
+    kOrgasm,
+    kVoiceSet
+};
+
+// One OStim.log line reduced to the event it carries. The string_view fields point into
+// the line that was parsed and are only valid as long as that buffer is.
+struct OStimEvent {
+    OStimEventKind kind = OStimEventKind::kNone;
+    std::string_view node;
+    std::string_view actor;
+    std::string_view gender;
+    int speed = -1;
+    bool resetsSpeed = false;
+};
+
+// An OStimEvent that owns its text, for handing a parsed line to another thread.
+struct OStimEventRecord {
+    OStimEventKind kind = OStimEventKind::kNone;
+    std::string node;
+    std::string actor;
+    std::string gender;
+    int speed = -1;
+    bool resetsSpeed = false;
+
+    OStimEventRecord() = default;
+    explicit OStimEventRecord(const OStimEvent& event)
+        : kind(event.kind), node(event.node), actor(event.actor), gender(event.gender), speed(event.speed),
+          resetsSpeed(event.resetsSpeed) {}
+
+    OStimEvent View() const { return {kind, node, actor, gender, speed, resetsSpeed}; }
+};
+
+inline std::string_view TrimOStimField(std::string_view value) {
+    constexpr std::string_view whitespace = " \t\r\n";
+    std::size_t first = value.find_first_not_of(whitespace);
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    return value.substr(first, value.find_last_not_of(whitespace) - first + 1);
+}
+
+inline std::string_view TrimOStimFieldRight(std::string_view value) {
+    std::size_t last = value.find_last_not_of(" \n\r\t");
+    return last == std::string_view::npos ? std::string_view{} : value.substr(0, last + 1);
+}
+
+// Fields like "actor:Lydia, gender:Female" end at the next comma, else the next space.
+inline std::string_view ExtractOStimField(std::string_view line, std::size_t start) {
+    std::size_t end = line.find(',', start);
+    if (end == std::string_view::npos) end = line.find(' ', start);
+    if (end == std::string_view::npos) end = line.size();
+    return TrimOStimField(line.substr(start, end - start));
+}
+
+inline OStimEvent ParseOStimEvent(std::string_view line, const OStimLineMatch& match) {
+    OStimEvent event;
+
+    switch (match.kind) {
+        case OStimLineKind::kOrgasm: {
+            if (!match.Has(OStimNeedle::kActorField)) {
+                break;
+            }
+            event.kind = OStimEventKind::kOrgasm;
+            event.actor = ExtractOStimField(line, match.End(OStimNeedle::kActorField));
+            event.gender = match.Has(OStimNeedle::kGenderField)
+                               ? ExtractOStimField(line, match.End(OStimNeedle::kGenderField))
+                               : std::string_view("Unknown");
+            break;
+        }
+
+        case OStimLineKind::kSpeedChange: {
+            std::size_t start = match.End(OStimNeedle::kChangedSpeed);
+            if (start >= line.size() || line[start] < '0' || line[start] > '9') {
+                break;
+            }
+            int speed = 0;
+            auto [ptr, ec] = std::from_chars(line.data() + start, line.data() + line.size(), speed);
+            if (ec != std::errc()) {
+                break;
+            }
+            event.kind = OStimEventKind::kSpeedChange;
+            event.speed = speed;
+            break;
+        }
+
+        case OStimLineKind::kSceneEnd:
+            event.kind = OStimEventKind::kSceneEnd;
+            break;
+
+        case OStimLineKind::kVoiceSet: {
+            std::size_t nameStart = match.End(OStimNeedle::kFoundForActor);
+            std::size_t nameEnd = std::min(line.find(" by", nameStart), line.find(", using", nameStart));
+            if (nameEnd == std::string_view::npos || nameEnd <= nameStart) {
+                break;
+            }
+            std::string_view name = TrimOStimField(line.substr(nameStart, nameEnd - nameStart));
+            if (name.empty() || name == ",") {
+                break;
+            }
+            event.kind = OStimEventKind::kVoiceSet;
+            event.actor = name;
+            break;
+        }
+
+        case OStimLineKind::kNodeChange: {
+            event.kind = OStimEventKind::kNodeChange;
+            event.resetsSpeed = true;
+            if (match.Has(OStimNeedle::kInfo)) {
+                std::size_t start = match.End(OStimNeedle::kThreadNodeChange) + 1;
+                if (start < line.size() && line[start - 1] == ' ') {
+                    event.node = TrimOStimFieldRight(line.substr(start));
+                }
+            }
+            break;
+        }
+
+        case OStimLineKind::kMenuTransition: {
+            std::size_t open = line.rfind('{');
+            std::size_t close = line.rfind('}');
+            if (open == std::string_view::npos || close == std::string_view::npos || close <= open) {
+                break;
+            }
+            std::string_view node = TrimOStimFieldRight(line.substr(open + 1, close - open - 1));
+            if (node.empty()) {
+                break;
+            }
+            event.kind = OStimEventKind::kNodeChange;
+            event.node = node;
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    return event;
+}
+
+inline OStimEvent ParseOStimEvent(std::string_view line) {
+    return ParseOStimEvent(line, OStimLineClassifier::GetSingleton().Classify(line));
+}
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+enum class OStimNeedle : std::uint8_t {
+    kWarning,
+    kInfo,
+    kActorOrgasm,
+    kActorField,
+    kGenderField,
+    kThreadSource,
+    kChangedSpeed,
+    kThreadNodeChange,
+    kThreadClosing,
+    kStopThread,
+    kVoiceSet,
+    kFoundForActor,
+    kMenuTransition,
+    kCount
+};
+
+inline constexpr std::array<std::string_view, static_cast<std::size_t>(OStimNeedle::kCount)> kOStimNeedles = {
+    "[warning]",
+    "[info]",
+    "ostim_actor_orgasm",
+    "actor:",
+    "gender:",
+    "[Thread.cpp",
+    "changed speed to ",
+    "[Thread.cpp:195] thread 0 changed to node",
+    "[Thread.cpp:634] closing thread",
+    "[ThreadManager.cpp:174] trying to stop thread",
+    "voice set",
+    "found for actor ",
+    "[OStimMenu.h:48] UI_TransitionRequest"
+};
+
+enum class OStimLineKind : std::uint8_t {
+    kNone,
+    kWarning,
+    kOrgasm,
+    kSpeedChange,
+    kNodeChange,
+    kSceneEnd,
+    kVoiceSet,
+    kMenuTransition
+};
+
+// Result of one pass over a line: which needles occur and where each first occurs,
+// matching what std::string::find would have returned for it.
+struct OStimLineMatch {
+    static constexpr std::size_t npos = std::string_view::npos;
+
+    OStimLineKind kind = OStimLineKind::kNone;
+    std::uint32_t found = 0;
+    std::array<std::size_t, static_cast<std::size_t>(OStimNeedle::kCount)> positions{};
+
+    bool Has(OStimNeedle needle) const { return (found >> static_cast<std::uint32_t>(needle)) & 1u; }
+
+    std::size_t Position(OStimNeedle needle) const {
+        return Has(needle) ? positions[static_cast<std::size_t>(needle)] : npos;
+    }
+
+    // Offset just past the needle, i.e. where the text following it starts.
+    std::size_t End(OStimNeedle needle) const {
+        return Has(needle) ? positions[static_cast<std::size_t>(needle)] +
+                                 kOStimNeedles[static_cast<std::size_t>(needle)].size()
+                           : npos;
+    }
+};
+
+// Aho-Corasick automaton over the OStim needles, flattened into a dense transition table.
+// Bytes that appear in no needle share one alphabet class, which keeps the table small
+// enough to stay in L1 while every line is scanned exactly once.
+class OStimLineClassifier {
+public:
+    static const OStimLineClassifier& GetSingleton() {
+        static const OStimLineClassifier singleton;
+        return singleton;
+    }
+
+    OStimLineMatch Classify(std::string_view line) const {
+        OStimLineMatch match;
+        constexpr std::uint32_t allFound = (1u << kNeedleCount) - 1;
+
+        std::uint16_t state = 0;
+        for (std::size_t i = 0; i < line.size(); i++) {
+            state = _transitions[state * _classCount + _byteClass[static_cast<unsigned char>(line[i])]];
+
+            std::uint32_t fresh = _outputs[state] & ~match.found;
+            if (fresh == 0) {
+                continue;
+            }
+
+            match.found |= fresh;
+            while (fresh) {
+                std::uint32_t bit = CountTrailingZeros(fresh);
+                match.positions[bit] = i + 1 - kOStimNeedles[bit].size();
+                fresh &= fresh - 1;
+            }
+
+            if (match.found == allFound) {
+                break;
+            }
+        }
+
+        match.kind = KindOf(match);
+        return match;
+    }
+
+private:
+    static constexpr std::uint32_t kNeedleCount = static_cast<std::uint32_t>(OStimNeedle::kCount);
+
+    static std::uint32_t CountTrailingZeros(std::uint32_t value) {
+        std::uint32_t count = 0;
+        while ((value & 1u) == 0) {
+            value >>= 1;
+            count++;
+        }
+        return count;
+    }
+
+    static OStimLineKind KindOf(const OStimLineMatch& match) {
+        if (match.found == 0) {
+            return OStimLineKind::kNone;
+        }
+        if (match.Has(OStimNeedle::kWarning)) {
+            return OStimLineKind::kWarning;
+        }
+        if (match.Has(OStimNeedle::kActorOrgasm)) {
+            return OStimLineKind::kOrgasm;
+        }
+        if (match.Has(OStimNeedle::kThreadSource) && match.Has(OStimNeedle::kChangedSpeed)) {
+            return OStimLineKind::kSpeedChange;
+        }
+        if (match.Has(OStimNeedle::kThreadClosing) || match.Has(OStimNeedle::kStopThread)) {
+            return OStimLineKind::kSceneEnd;
+        }
+        if (match.Has(OStimNeedle::kVoiceSet) && match.Has(OStimNeedle::kFoundForActor)) {
+            return OStimLineKind::kVoiceSet;
+        }
+        if (match.Has(OStimNeedle::kThreadNodeChange)) {
+            return OStimLineKind::kNodeChange;
+        }
+        if (match.Has(OStimNeedle::kInfo) && match.Has(OStimNeedle::kMenuTransition)) {
+            return OStimLineKind::kMenuTransition;
+        }
+        return OStimLineKind::kNone;
+    }
+
+    OStimLineClassifier() {
+        _byteClass.fill(0);
+        for (auto needle : kOStimNeedles) {
+            for (char c : needle) {
+                auto& cls = _byteClass[static_cast<unsigned char>(c)];
+                if (cls == 0) {
+                    cls = static_cast<std::uint8_t>(_classCount++);
+                }
+            }
+        }
+
+        // Trie with -1 marking missing edges, then breadth-first failure links turn it
+        // into a complete DFA.
+        std::vector<std::int32_t> trie(_classCount, -1);
+        _outputs.push_back(0);
+
+        for (std::uint32_t n = 0; n < kNeedleCount; n++) {
+            std::size_t node = 0;
+            for (char c : kOStimNeedles[n]) {
+                std::size_t edge = node * _classCount + _byteClass[static_cast<unsigned char>(c)];
+                if (trie[edge] < 0) {
+                    trie[edge] = static_cast<std::int32_t>(_outputs.size());
+                    _outputs.push_back(0);
+                    trie.resize(trie.size() + _classCount, -1);
+                }
+                node = static_cast<std::size_t>(trie[edge]);
+            }
+            _outputs[node] |= 1u << n;
+        }
+
+        std::size_t stateCount = _outputs.size();
+        _transitions.assign(stateCount * _classCount, 0);
+        std::vector<std::uint16_t> failure(stateCount, 0);
+        std::vector<std::uint16_t> queue;
+        queue.reserve(stateCount);
+
+        for (std::size_t cls = 0; cls < _classCount; cls++) {
+            std::int32_t child = trie[cls];
+            if (child > 0) {
+                _transitions[cls] = static_cast<std::uint16_t>(child);
+                queue.push_back(static_cast<std::uint16_t>(child));
+            }
+        }
+
+        for (std::size_t head = 0; head < queue.size(); head++) {
+            std::uint16_t state = queue[head];
+            _outputs[state] |= _outputs[failure[state]];
+
+            for (std::size_t cls = 0; cls < _classCount; cls++) {
+                std::int32_t child = trie[state * _classCount + cls];
+                std::uint16_t viaFailure = _transitions[failure[state] * _classCount + cls];
+                if (child > 0) {
+                    failure[child] = viaFailure;
+                    _transitions[state * _classCount + cls] = static_cast<std::uint16_t>(child);
+                    queue.push_back(static_cast<std::uint16_t>(child));
+                } else {
+                    _transitions[state * _classCount + cls] = viaFailure;
+                }
+            }
+        }
+    }
+
+    std::array<std::uint8_t, 256> _byteClass{};
+    std::size_t _classCount = 1;
+    std::vector<std::uint16_t> _transitions;
+    std::vector<std::uint32_t> _outputs;
+};
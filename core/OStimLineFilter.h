@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+#include "OStimEventParser.h"
+#include "RecentLineSet.h"
+
+// One OStim.log line that carries an event, as the reader stage hands it on.
+struct OStimLogLine {
+    OStimEvent event;
+    bool threadClosing = false;
+};
+
+// The reader side of OStim.log processing: classifies and parses a line and drops repeats
+// of scene-end and node lines that already took effect. Speed, orgasm and voice-set lines
+// are never remembered, so a repeated one is passed on again.
+class OStimLineFilter {
+public:
+    // False when the line carries no event or repeats one that already took effect. On true,
+    // out.event points into line.
+    bool Parse(std::string_view line, OStimLogLine& out) {
+        std::uint64_t lineHash = 0;
+        return ParseLine(line, out, lineHash) && Admit(lineHash, out.event);
+    }
+
+    // The stateless half of Parse(): classifies and parses the line and hashes it for Admit().
+    // False when the line carries no event. Safe from any thread.
+    static bool ParseLine(std::string_view line, OStimLogLine& out, std::uint64_t& lineHash) {
+        OStimLineMatch match = OStimLineClassifier::GetSingleton().Classify(line);
+        OStimEvent event = ParseOStimEvent(line, match);
+        if (event.kind == OStimEventKind::kNone) {
+            return false;
+        }
+
+        lineHash = std::hash<std::string_view>{}(line);
+        out.event = event;
+        out.threadClosing = match.Has(OStimNeedle::kThreadClosing);
+        return true;
+    }
+
+    // The stateful half: false when the line repeats one that already took effect. Lines must
+    // come in file order.
+    bool Admit(std::uint64_t lineHash, const OStimEvent& event) {
+        if (_seen.Contains(lineHash)) {
+            return false;
+        }
+        if (event.kind == OStimEventKind::kSceneEnd ||
+            (event.kind == OStimEventKind::kNodeChange && !event.node.empty())) {
+            _seen.Insert(lineHash);
+        }
+        return true;
+    }
+
+    // The log was truncated or replaced; lines seen before may legitimately come back.
+    void Clear() { _seen.Clear(); }
+
+private:
+    RecentLineSet<512> _seen;
+};
@@ -0,0 +1,235 @@
+#include "OStimLogTailer.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+OStimLogTailer::~OStimLogTailer() {
+    Close();
+}
+
+void OStimLogTailer::SetCandidates(std::vector<fs::path> candidates) {
+    _candidates = std::move(candidates);
+    Reset();
+}
+
+void OStimLogTailer::Reset() {
+    Close();
+    _position = 0;
+    _fileSize = 0;
+    _carry = 0;
+    _scanned = 0;
+}
+
+OStimLogTailer::Status OStimLogTailer::Refresh() {
+    bool rotated = false;
+
+    if (IsOpen()) {
+        auto now = std::chrono::steady_clock::now();
+        if (now - _lastIdentityCheck >= kIdentityCheckInterval) {
+            _lastIdentityCheck = now;
+            if (!IsStillActiveFile()) {
+                Reset();
+                rotated = true;
+            }
+        }
+    }
+
+    if (!IsOpen() && !OpenFirstCandidate()) {
+        return Status::kMissing;
+    }
+
+    std::uint64_t size = 0;
+    if (!QuerySize(size)) {
+        Reset();
+        return Status::kMissing;
+    }
+
+    if (size < _position) {
+        _position = 0;
+        _carry = 0;
+        _scanned = 0;
+        _fileSize = size;
+        return Status::kTruncated;
+    }
+
+    _fileSize = size;
+
+    if (rotated) {
+        return Status::kRotated;
+    }
+    return HasBacklog() ? Status::kAppended : Status::kUnchanged;
+}
+
+void OStimLogTailer::SeekToEnd() {
+    _carry = 0;
+    _scanned = 0;
+    _position = _fileSize;
+
+    // Back up to just past the last newline, looking no further back than one line can be.
+    std::vector<char> chunk(kChunkSize);
+    std::uint64_t end = _fileSize;
+    while (IsOpen() && end > 0 && _fileSize - end < kMaxLineLength) {
+        std::size_t want = static_cast<std::size_t>(std::min<std::uint64_t>(kChunkSize, end));
+        if (ReadAt(end - want, chunk.data(), want) != want) {
+            return;
+        }
+        for (std::size_t i = want; i > 0; i--) {
+            if (chunk[i - 1] == '\n') {
+                _position = end - want + i;
+                return;
+            }
+        }
+        end -= want;
+    }
+    if (end == 0) {
+        _position = 0;
+    }
+}
+
+bool OStimLogTailer::OpenFirstCandidate() {
+    for (const auto& candidate : _candidates) {
+        if (Open(candidate)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// The active file stops being authoritative when it was deleted or replaced on disk, or
+// when a higher-priority candidate path appeared after we settled on a fallback.
+bool OStimLogTailer::IsStillActiveFile() const {
+    std::error_code ec;
+    for (const auto& candidate : _candidates) {
+        if (candidate == _activePath) {
+            break;
+        }
+        if (fs::exists(candidate, ec)) {
+            return false;
+        }
+    }
+
+#ifdef _WIN32
+    HANDLE probe = CreateFileW(_activePath.wstring().c_str(), 0,
+                               FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                               FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (probe == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    BY_HANDLE_FILE_INFORMATION held{};
+    BY_HANDLE_FILE_INFORMATION onDisk{};
+    bool same = GetFileInformationByHandle(static_cast<HANDLE>(_handle), &held) &&
+                GetFileInformationByHandle(probe, &onDisk) &&
+                held.dwVolumeSerialNumber == onDisk.dwVolumeSerialNumber &&
+                held.nFileIndexHigh == onDisk.nFileIndexHigh && held.nFileIndexLow == onDisk.nFileIndexLow;
+    CloseHandle(probe);
+    return same;
+#else
+    struct stat held {};
+    struct stat onDisk {};
+    if (fstat(_fd, &held) != 0 || stat(_activePath.c_str(), &onDisk) != 0) {
+        return false;
+    }
+    return held.st_dev == onDisk.st_dev && held.st_ino == onDisk.st_ino;
+#endif
+}
+
+#ifdef _WIN32
+
+bool OStimLogTailer::IsOpen() const {
+    return _handle != INVALID_HANDLE_VALUE;
+}
+
+bool OStimLogTailer::Open(const fs::path& path) {
+    HANDLE handle = CreateFileW(path.wstring().c_str(), GENERIC_READ,
+                                FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    _handle = handle;
+    _activePath = path;
+    _lastIdentityCheck = std::chrono::steady_clock::now();
+    return true;
+}
+
+void OStimLogTailer::Close() {
+    if (_handle != INVALID_HANDLE_VALUE) {
+        CloseHandle(static_cast<HANDLE>(_handle));
+        _handle = INVALID_HANDLE_VALUE;
+    }
+    _activePath.clear();
+}
+
+bool OStimLogTailer::QuerySize(std::uint64_t& size) const {
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(static_cast<HANDLE>(_handle), &fileSize)) {
+        return false;
+    }
+    size = static_cast<std::uint64_t>(fileSize.QuadPart);
+    return true;
+}
+
+std::size_t OStimLogTailer::ReadAt(std::uint64_t offset, char* dest, std::size_t count) const {
+    OVERLAPPED overlapped{};
+    overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+    DWORD bytesRead = 0;
+    if (!ReadFile(static_cast<HANDLE>(_handle), dest, static_cast<DWORD>(count), &bytesRead, &overlapped)) {
+        return 0;
+    }
+    return bytesRead;
+}
+
+#else
+
+bool OStimLogTailer::IsOpen() const {
+    return _fd >= 0;
+}
+
+bool OStimLogTailer::Open(const fs::path& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    _fd = fd;
+    _activePath = path;
+    _lastIdentityCheck = std::chrono::steady_clock::now();
+    return true;
+}
+
+void OStimLogTailer::Close() {
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+    _activePath.clear();
+}
+
+bool OStimLogTailer::QuerySize(std::uint64_t& size) const {
+    struct stat info {};
+    if (fstat(_fd, &info) != 0) {
+        return false;
+    }
+    size = static_cast<std::uint64_t>(info.st_size);
+    return true;
+}
+
+std::size_t OStimLogTailer::ReadAt(std::uint64_t offset, char* dest, std::size_t count) const {
+    ssize_t bytesRead = ::pread(_fd, dest, count, static_cast<off_t>(offset));
+    return bytesRead > 0 ? static_cast<std::size_t>(bytesRead) : 0;
+}
+
+#endif
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+// Keeps OStim.log open between polls and hands out only the bytes appended since the
+// previous read, split into lines in a reusable buffer. A trailing line without its
+// newline is carried over to the next read instead of being processed half-written.
+class OStimLogTailer {
+public:
+    enum class Status {
+        kMissing,
+        kUnchanged,
+        kAppended,
+        kTruncated,
+        kRotated
+    };
+
+    static constexpr std::size_t kChunkSize = 64 * 1024;
+    static constexpr std::size_t kMaxLineLength = 1024 * 1024;
+    static constexpr std::chrono::seconds kIdentityCheckInterval{5};
+    static constexpr std::size_t kBudgetCheckInterval = 64;
+
+    // How much one ReadLines() call may hand out. The clock is only looked at every
+    // kBudgetCheckInterval lines.
+    struct ReadBudget {
+        std::size_t maxLines = std::numeric_limits<std::size_t>::max();
+        std::chrono::steady_clock::duration maxTime = std::chrono::steady_clock::duration::max();
+    };
+
+    OStimLogTailer() = default;
+    ~OStimLogTailer();
+    OStimLogTailer(const OStimLogTailer&) = delete;
+    OStimLogTailer& operator=(const OStimLogTailer&) = delete;
+
+    void SetCandidates(std::vector<std::filesystem::path> candidates);
+    void Reset();
+
+    // Picks up size changes through the open handle. Truncation rewinds to byte 0 and
+    // a replaced or deleted file is reopened; both are reported so callers can drop
+    // state that belonged to the old contents. kAppended whenever HasBacklog().
+    Status Refresh();
+
+    // Hands every complete line appended so far to onLine, or as many as the budget allows;
+    // the rest stay buffered and go out first on the next call, so a large backlog can be
+    // worked off in slices.
+    template <class Fn>
+    std::size_t ReadLines(Fn&& onLine, const ReadBudget& budget = {});
+
+    // Moves the read position to the end of the file, skipping what it already holds. A last
+    // line still missing its newline is left to be read once it is complete.
+    void SeekToEnd();
+
+    // Hands the complete lines before the read position to onLine newest first, reading the
+    // file backward a chunk at a time, until onLine returns false or maxBytes were read. Does
+    // not move the read position.
+    template <class Fn>
+    std::size_t ReadLinesBackward(std::uint64_t maxBytes, Fn&& onLine);
+
+    bool IsOpen() const;
+    const std::filesystem::path& GetActivePath() const { return _activePath; }
+    std::uint64_t GetPosition() const { return _position; }
+    std::uint64_t GetFileSize() const { return _fileSize; }
+
+    // Bytes known to be in the file that have not been handed out yet, as of the last Refresh().
+    std::uint64_t GetBacklogBytes() const { return _fileSize - _position + _carry; }
+
+    // Whether ReadLines() could hand out more right now: unread bytes, or buffered lines a
+    // budget held back. A half-written last line alone does not count.
+    bool HasBacklog() const { return _position < _fileSize || _carry > _scanned; }
+
+private:
+    bool OpenFirstCandidate();
+    bool Open(const std::filesystem::path& path);
+    void Close();
+    bool QuerySize(std::uint64_t& size) const;
+    bool IsStillActiveFile() const;
+    std::size_t ReadAt(std::uint64_t offset, char* dest, std::size_t count) const;
+
+    std::vector<std::filesystem::path> _candidates;
+    std::filesystem::path _activePath;
+#ifdef _WIN32
+    void* _handle = reinterpret_cast<void*>(-1);
+#else
+    int _fd = -1;
+#endif
+    std::uint64_t _position = 0;
+    std::uint64_t _fileSize = 0;
+    std::vector<char> _buffer;
+    // Bytes at the start of _buffer not handed out yet; the first _scanned of them hold no
+    // newline.
+    std::size_t _carry = 0;
+    std::size_t _scanned = 0;
+    std::chrono::steady_clock::time_point _lastIdentityCheck;
+};
+
+template <class Fn>
+std::size_t OStimLogTailer::ReadLines(Fn&& onLine, const ReadBudget& budget) {
+    std::size_t lineCount = 0;
+    bool timed = budget.maxTime != std::chrono::steady_clock::duration::max();
+    auto deadline = timed ? std::chrono::steady_clock::now() + budget.maxTime
+                          : std::chrono::steady_clock::time_point::max();
+    auto exhausted = [&] {
+        if (lineCount >= budget.maxLines) {
+            return true;
+        }
+        return timed && lineCount > 0 && lineCount % kBudgetCheckInterval == 0 &&
+               std::chrono::steady_clock::now() >= deadline;
+    };
+
+    while (IsOpen()) {
+        // Complete lines a previous call left in the buffer go out before anything new is read.
+        char* data = _buffer.data();
+        std::size_t lineStart = 0;
+        std::size_t scanFrom = _scanned;
+        bool stopped = false;
+
+        while (scanFrom < _carry) {
+            if (exhausted()) {
+                stopped = true;
+                break;
+            }
+
+            auto* newline = static_cast<char*>(std::memchr(data + scanFrom, '\n', _carry - scanFrom));
+            if (!newline) {
+                scanFrom = _carry;
+                break;
+            }
+
+            std::size_t lineEnd = static_cast<std::size_t>(newline - data);
+            std::size_t length = lineEnd - lineStart;
+            if (length > 0 && data[lineStart + length - 1] == '\r') {
+                length--;
+            }
+
+            onLine(std::string_view(data + lineStart, length));
+            lineCount++;
+
+            lineStart = lineEnd + 1;
+            scanFrom = lineStart;
+        }
+
+        _carry -= lineStart;
+        _scanned = scanFrom - lineStart;
+        if (_carry > 0 && lineStart > 0) {
+            std::memmove(data, data + lineStart, _carry);
+        }
+        if (stopped) {
+            break;
+        }
+
+        if (_carry > kMaxLineLength) {
+            onLine(std::string_view(data, _carry));
+            lineCount++;
+            _carry = 0;
+            _scanned = 0;
+        }
+
+        if (_position >= _fileSize || exhausted()) {
+            break;
+        }
+
+        std::size_t want = static_cast<std::size_t>(std::min<std::uint64_t>(kChunkSize, _fileSize - _position));
+        if (_buffer.size() < _carry + want) {
+            _buffer.resize(_carry + want);
+        }
+
+        std::size_t got = ReadAt(_position, _buffer.data() + _carry, want);
+        if (got == 0) {
+            break;
+        }
+        _position += got;
+        _carry += got;
+    }
+
+    return lineCount;
+}
+
+template <class Fn>
+std::size_t OStimLogTailer::ReadLinesBackward(std::uint64_t maxBytes, Fn&& onLine) {
+    std::size_t lineCount = 0;
+
+    // window holds the file bytes [windowStart, windowStart + window.size()): the lines not yet
+    // handed out, the oldest of which may still be missing its start.
+    std::vector<char> window;
+    std::uint64_t windowStart = _position;
+    std::uint64_t bytesRead = 0;
+
+    while (IsOpen() && windowStart > 0 && bytesRead < maxBytes) {
+        std::size_t want = static_cast<std::size_t>(
+            std::min<std::uint64_t>({kChunkSize, windowStart, maxBytes - bytesRead}));
+        window.insert(window.begin(), want, '\0');
+        if (ReadAt(windowStart - want, window.data(), want) != want) {
+            break;
+        }
+        windowStart -= want;
+        bytesRead += want;
+
+        std::string_view text(window.data(), window.size());
+        std::size_t end = text.size();
+        while (end > 0) {
+            std::size_t lineEnd = text[end - 1] == '\n' ? end - 1 : end;
+            std::size_t newline = lineEnd > 0 ? text.rfind('\n', lineEnd - 1) : std::string_view::npos;
+            if (newline == std::string_view::npos && windowStart > 0) {
+                break;
+            }
+
+            std::size_t lineStart = newline == std::string_view::npos ? 0 : newline + 1;
+            std::size_t length = lineEnd - lineStart;
+            if (length > 0 && text[lineStart + length - 1] == '\r') {
+                length--;
+            }
+
+            lineCount++;
+            if (!onLine(text.substr(lineStart, length))) {
+                return lineCount;
+            }
+            end = lineStart;
+        }
+        window.resize(end);
+    }
+
+    return lineCount;
+}
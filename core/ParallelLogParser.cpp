@@ -0,0 +1,137 @@
+#include "ParallelLogParser.h"
+
+#include <algorithm>
+#include <thread>
+
+ParallelLogParser::ParallelLogParser(unsigned workers, std::size_t chunkBytes)
+    : _workers(workers ? workers : std::max(1u, std::thread::hardware_concurrency())),
+      _chunkBytes(std::max<std::size_t>(chunkBytes, 1)) {}
+
+ParallelLogParser::Stats ParallelLogParser::Parse(std::string_view text, const ChunkHandler& onChunk) {
+    Stats stats;
+    std::size_t end = text.rfind('\n');
+    if (end == std::string_view::npos) {
+        return stats;
+    }
+    text = text.substr(0, end + 1);
+
+    Run run(std::size_t{_workers} * kWindowPerWorker);
+    run.text = text;
+    run.chunks = (text.size() + _chunkBytes - 1) / _chunkBytes;
+    run.window = run.slots.size();
+
+    std::vector<std::thread> workers;
+    workers.reserve(_workers);
+    for (unsigned i = 0; i < _workers; i++) {
+        workers.emplace_back([this, &run] { WorkerThread(run); });
+    }
+
+    auto stopWorkers = [&] {
+        // Moving folded on wakes any worker waiting for the window, which then sees stop.
+        run.stop.store(true);
+        run.folded.fetch_add(1);
+        run.folded.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    };
+
+    try {
+        for (std::uint64_t chunk = 0; chunk < run.chunks; chunk++) {
+            Slot& slot = run.slots[chunk % run.window];
+            for (std::uint64_t ready = slot.ready.load(std::memory_order_acquire); ready != chunk + 1;
+                 ready = slot.ready.load(std::memory_order_acquire)) {
+                slot.ready.wait(ready, std::memory_order_acquire);
+            }
+            if (slot.error) {
+                std::rethrow_exception(slot.error);
+            }
+
+            for (Line& line : slot.events) {
+                line.index += stats.lines;
+            }
+            onChunk(Chunk{stats.lines, slot.lineCount, slot.events});
+            stats.lines += slot.lineCount;
+            stats.events += slot.events.size();
+            stats.chunks++;
+
+            slot.events.clear();
+            run.folded.store(chunk + 1, std::memory_order_release);
+            run.folded.notify_all();
+        }
+    } catch (...) {
+        stopWorkers();
+        throw;
+    }
+
+    stopWorkers();
+    stats.bytes = text.size();
+    return stats;
+}
+
+void ParallelLogParser::WorkerThread(Run& run) const {
+    while (true) {
+        std::uint64_t chunk = run.next.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= run.chunks) {
+            return;
+        }
+
+        // The slot is free once the chunk a window back has been folded.
+        while (true) {
+            if (run.stop.load()) {
+                return;
+            }
+            std::uint64_t folded = run.folded.load(std::memory_order_acquire);
+            if (chunk < folded + run.window) {
+                break;
+            }
+            run.folded.wait(folded, std::memory_order_acquire);
+        }
+
+        Slot& slot = run.slots[chunk % run.window];
+        try {
+            ParseChunk(run, chunk, slot);
+        } catch (...) {
+            slot.error = std::current_exception();
+        }
+        slot.ready.store(chunk + 1, std::memory_order_release);
+        slot.ready.notify_one();
+    }
+}
+
+// A chunk owns the lines that start inside its byte range; a line starts at 0 and after every
+// '\n'. A line that runs on past the range still belongs to the chunk it started in.
+void ParallelLogParser::ParseChunk(const Run& run, std::uint64_t chunk, Slot& slot) const {
+    std::string_view text = run.text;
+    auto lineStartAtOrAfter = [text](std::size_t offset) {
+        if (offset == 0) {
+            return std::size_t{0};
+        }
+        if (offset >= text.size()) {
+            return text.size();
+        }
+        std::size_t newline = text.find('\n', offset - 1);
+        return newline == std::string_view::npos ? text.size() : newline + 1;
+    };
+
+    std::size_t begin = lineStartAtOrAfter(static_cast<std::size_t>(chunk * _chunkBytes));
+    std::size_t end = lineStartAtOrAfter(static_cast<std::size_t>(std::min<std::uint64_t>(
+        (chunk + 1) * _chunkBytes, text.size())));
+
+    slot.lineCount = 0;
+    while (begin < end) {
+        std::size_t newline = text.find('\n', begin);
+        std::size_t length = newline - begin;
+        if (length > 0 && text[begin + length - 1] == '\r') {
+            length--;
+        }
+
+        Line line;
+        if (OStimLineFilter::ParseLine(text.substr(begin, length), line.parsed, line.hash)) {
+            line.index = slot.lineCount;
+            slot.events.push_back(line);
+        }
+        slot.lineCount++;
+        begin = newline + 1;
+    }
+}
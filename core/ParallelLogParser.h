@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "OStimLineFilter.h"
+
+// Classifies and parses a whole OStim.log held in memory (see MappedFile) on a pool of worker
+// threads, for full replays of logs that run to hundreds of megabytes. The text is cut into
+// chunks of about kDefaultChunkBytes at newline boundaries, workers run the stateless
+// OStimLineFilter::ParseLine() on whole chunks, and the calling thread gets the event lines
+// back one chunk at a time in file order, so everything stateful (the line filter's Admit(),
+// the scene state machine, rewards) folds over them exactly as it would over a sequential read.
+// At most kWindowPerWorker chunks per worker are parsed ahead of the fold.
+//
+// Unlike OStimLogTailer, lines longer than kMaxLineLength are not cut up; none of them carry
+// an event, so only the line count can differ on such a file.
+class ParallelLogParser {
+public:
+    static constexpr std::size_t kDefaultChunkBytes = 1024 * 1024;
+    static constexpr std::size_t kWindowPerWorker = 4;
+
+    // One line that carries an event. parsed.event points into the parsed text.
+    struct Line {
+        std::uint64_t index = 0;
+        std::uint64_t hash = 0;
+        OStimLogLine parsed;
+    };
+
+    struct Chunk {
+        std::uint64_t firstLine = 0;
+        std::uint64_t lineCount = 0;
+        std::span<const Line> events;
+    };
+
+    struct Stats {
+        std::uint64_t chunks = 0;
+        std::uint64_t lines = 0;
+        std::uint64_t events = 0;
+        std::uint64_t bytes = 0;
+    };
+
+    using ChunkHandler = std::function<void(const Chunk&)>;
+
+    // Zero workers means one per hardware thread.
+    explicit ParallelLogParser(unsigned workers = 0, std::size_t chunkBytes = kDefaultChunkBytes);
+
+    unsigned GetWorkers() const { return _workers; }
+
+    // Hands every chunk of text to onChunk on the calling thread, in order. Lines end at '\n'
+    // with a trailing '\r' dropped, as the tailer splits them; a last line without its newline
+    // is left out, as the tailer would carry it. An exception from onChunk stops the workers
+    // and is rethrown.
+    Stats Parse(std::string_view text, const ChunkHandler& onChunk);
+
+private:
+    struct Slot {
+        std::atomic<std::uint64_t> ready{0};  // chunk index + 1 once parsed
+        std::vector<Line> events;
+        std::uint64_t lineCount = 0;
+        std::exception_ptr error;
+    };
+
+    struct Run {
+        std::string_view text;
+        std::uint64_t chunks = 0;
+        std::uint64_t window = 0;
+        std::vector<Slot> slots;
+        std::atomic<std::uint64_t> next{0};
+        std::atomic<std::uint64_t> folded{0};
+        std::atomic<bool> stop{false};
+
+        explicit Run(std::size_t slotCount) : slots(slotCount) {}
+    };
+
+    void WorkerThread(Run& run) const;
+    void ParseChunk(const Run& run, std::uint64_t chunk, Slot& slot) const;
+
+    unsigned _workers;
+    std::size_t _chunkBytes;
+};
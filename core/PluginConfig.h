@@ -0,0 +1,363 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "IniSchema.h"
+#include "RewardTable.h"
+
+// OSurvival-Mode-NG.ini and OSurvival-Mode-NG-Climax.ini as plain structs, with the schemas
+// that map them to INI sections and keys.
+struct PluginConfig {
+    struct {
+        bool enabled = true;
+        int amount = 300;
+        int intervalMinutes = 7;
+        bool showNotification = true;
+    } gold;
+
+    struct {
+        bool enabled = true;
+        int reductionAmountHunger = 100;
+        int reductionAmountCold = 100;
+        int reductionAmountExhaustion = 100;
+        int intervalSeconds = 60;
+        int activationThreshold = 100;
+        bool showNotification = true;
+    } survival;
+
+    struct {
+        bool enabled = true;
+        int restorationAmount = 50;
+        int intervalSeconds = 120;
+        bool showNotification = true;
+    } attributes;
+
+    struct {
+        bool enabled = false;
+        std::string itemName = "none";
+        std::string id = "xxxxxx";
+        std::string plugin = "none";
+        int amount = 1;
+        int intervalMinutes = 1;
+        bool showNotification = true;
+    } item1;
+
+    struct {
+        bool enabled = false;
+        std::string itemName = "none";
+        std::string id = "xxxxxx";
+        std::string plugin = "none";
+        int amount = 1;
+        int intervalMinutes = 1;
+        bool showNotification = true;
+    } item2;
+
+    struct {
+        bool enabled = true;
+        std::string id = "003534";
+        std::string plugin = "Dawnguard.esm";
+        int amount = 3;
+        int intervalMinutes = 3;
+        bool showNotification = true;
+    } milk;
+
+    struct {
+        bool enabled = true;
+        std::string id = "000D73";
+        std::string plugin = "YurianaWench.esp";
+        int amount = 3;
+        int intervalMinutes = 3;
+        bool showNotification = true;
+    } milkWench;
+
+    struct {
+        bool enabled = true;
+        std::string id = "65FEC3";
+        std::string pluginItem = "YurianaWench.esp";
+        std::string npc = "576A03";
+        std::string pluginNPC = "YurianaWench.esp";
+        int amount = 1;
+        int intervalMinutes = 3;
+        bool showNotification = true;
+    } milkEthel;
+
+    struct {
+        bool enabled = true;
+        int reductionAmountCold = 100;
+        int intervalSeconds = 60;
+        int activationThreshold = 100;
+        bool showNotification = true;
+    } frostfall;
+
+    struct {
+        bool enabled = true;
+    } notification;
+
+    struct {
+        bool resumeAtTail = true;
+        int resumeScanKB = 1024;
+        int sliceLines = 2000;
+        int sliceMilliseconds = 5;
+    } ostimLog;
+
+    std::vector<RewardDefinition> rewards;
+};
+
+struct PluginConfigClimax {
+    struct {
+        bool enabled = true;
+        int amount = 300;
+        std::string event = "ostim_actor_orgasm";
+        bool male = true;
+        bool female = true;
+        bool showNotification = true;
+    } gold;
+
+    struct {
+        bool enabled = true;
+        int reductionAmountHunger = 100;
+        int reductionAmountCold = 100;
+        int reductionAmountExhaustion = 100;
+        int activationThreshold = 100;
+        std::string event = "ostim_actor_orgasm";
+        bool male = true;
+        bool female = true;
+        bool showNotification = true;
+    } survival;
+
+    struct {
+        bool enabled = true;
+        int restorationAmount = 50;
+        std::string event = "ostim_actor_orgasm";
+        bool male = true;
+        bool female = true;
+        bool showNotification = true;
+    } attributes;
+
+    struct {
+        bool enabled = false;
+        std::string itemName = "none";
+        std::string id = "xxxxxx";
+        std::string plugin = "none";
+        int amount = 1;
+        std::string event = "ostim_actor_orgasm";
+        bool male = true;
+        bool female = true;
+        bool showNotification = true;
+    } item1;
+
+    struct {
+        bool enabled = false;
+        std::string itemName = "none";
+        std::string id = "xxxxxx";
+        std::string plugin = "none";
+        int amount = 1;
+        std::string event = "ostim_actor_orgasm";
+        bool male = true;
+        bool female = true;
+        bool showNotification = true;
+    } item2;
+
+    struct {
+        bool enabled = false;
+        std::string id = "003534";
+        std::string plugin = "HearthFires.esm";
+        int amount = 1;
+        std::string event = "ostim_actor_orgasm";
+        bool male = true;
+        bool female = true;
+        bool showNotification = true;
+    } milk;
+
+    struct {
+        bool enabled = false;
+        std::string id = "000D73";
+        std::string plugin = "YurianaWench.esp";
+        int amount = 1;
+        std::string event = "ostim_actor_orgasm";
+        bool male = true;
+        bool female = true;
+        bool showNotification = true;
+    } milkWench;
+
+    struct {
+        bool enabled = false;
+        std::string id = "65FEC3";
+        std::string pluginItem = "YurianaWench.esp";
+        std::string npc = "576A03";
+        std::string pluginNPC = "YurianaWench.esp";
+        int amount = 1;
+        std::string event = "ostim_actor_orgasm";
+        bool male = true;
+        bool female = true;
+        bool showNotification = true;
+    } milkEthel;
+};
+
+inline constexpr auto kPluginConfigSchema = MakeIniSchema<PluginConfig>({
+    {"Gold", "Enabled", [](PluginConfig& c) { return IniRef(c.gold.enabled); }},
+    {"Gold", "Amount", [](PluginConfig& c) { return IniRef(c.gold.amount); }},
+    {"Gold", "IntervalMinutes", [](PluginConfig& c) { return IniRef(c.gold.intervalMinutes); }},
+    {"Gold", "ShowNotification", [](PluginConfig& c) { return IniRef(c.gold.showNotification); }},
+    {"Survival", "Enabled", [](PluginConfig& c) { return IniRef(c.survival.enabled); }},
+    {"Survival", "ReductionAmount_HungerNeedValue", [](PluginConfig& c) { return IniRef(c.survival.reductionAmountHunger); }},
+    {"Survival", "ReductionAmount_ColdNeedValue", [](PluginConfig& c) { return IniRef(c.survival.reductionAmountCold); }},
+    {"Survival", "ReductionAmount_ExhaustionNeedValue", [](PluginConfig& c) { return IniRef(c.survival.reductionAmountExhaustion); }},
+    {"Survival", "IntervalSeconds", [](PluginConfig& c) { return IniRef(c.survival.intervalSeconds); }},
+    {"Survival", "ActivationThreshold", [](PluginConfig& c) { return IniRef(c.survival.activationThreshold); }},
+    {"Survival", "ShowNotification", [](PluginConfig& c) { return IniRef(c.survival.showNotification); }},
+    {"Attributes", "Enabled", [](PluginConfig& c) { return IniRef(c.attributes.enabled); }},
+    {"Attributes", "RestorationAmount", [](PluginConfig& c) { return IniRef(c.attributes.restorationAmount); }},
+    {"Attributes", "IntervalSeconds", [](PluginConfig& c) { return IniRef(c.attributes.intervalSeconds); }},
+    {"Attributes", "ShowNotification", [](PluginConfig& c) { return IniRef(c.attributes.showNotification); }},
+    {"Item1", "Enabled", [](PluginConfig& c) { return IniRef(c.item1.enabled); }},
+    {"Item1", "ItemName", [](PluginConfig& c) { return IniRef(c.item1.itemName); }},
+    {"Item1", "ID", [](PluginConfig& c) { return IniRef(c.item1.id); }},
+    {"Item1", "Plugin", [](PluginConfig& c) { return IniRef(c.item1.plugin); }},
+    {"Item1", "Amount", [](PluginConfig& c) { return IniRef(c.item1.amount); }},
+    {"Item1", "IntervalMinutes", [](PluginConfig& c) { return IniRef(c.item1.intervalMinutes); }},
+    {"Item1", "ShowNotification", [](PluginConfig& c) { return IniRef(c.item1.showNotification); }},
+    {"Item2", "Enabled", [](PluginConfig& c) { return IniRef(c.item2.enabled); }},
+    {"Item2", "ItemName", [](PluginConfig& c) { return IniRef(c.item2.itemName); }},
+    {"Item2", "ID", [](PluginConfig& c) { return IniRef(c.item2.id); }},
+    {"Item2", "Plugin", [](PluginConfig& c) { return IniRef(c.item2.plugin); }},
+    {"Item2", "Amount", [](PluginConfig& c) { return IniRef(c.item2.amount); }},
+    {"Item2", "IntervalMinutes", [](PluginConfig& c) { return IniRef(c.item2.intervalMinutes); }},
+    {"Item2", "ShowNotification", [](PluginConfig& c) { return IniRef(c.item2.showNotification); }},
+    {"Milk", "Enabled", [](PluginConfig& c) { return IniRef(c.milk.enabled); }},
+    {"Milk", "ID", [](PluginConfig& c) { return IniRef(c.milk.id); }},
+    {"Milk", "Plugin", [](PluginConfig& c) { return IniRef(c.milk.plugin); }},
+    {"Milk", "Amount", [](PluginConfig& c) { return IniRef(c.milk.amount); }},
+    {"Milk", "IntervalMinutes", [](PluginConfig& c) { return IniRef(c.milk.intervalMinutes); }},
+    {"Milk", "ShowNotification", [](PluginConfig& c) { return IniRef(c.milk.showNotification); }},
+    {"BWY_Wench_Milk", "Enabled", [](PluginConfig& c) { return IniRef(c.milkWench.enabled); }},
+    {"BWY_Wench_Milk", "ID", [](PluginConfig& c) { return IniRef(c.milkWench.id); }},
+    {"BWY_Wench_Milk", "Plugin", [](PluginConfig& c) { return IniRef(c.milkWench.plugin); }},
+    {"BWY_Wench_Milk", "Amount", [](PluginConfig& c) { return IniRef(c.milkWench.amount); }},
+    {"BWY_Wench_Milk", "IntervalMinutes", [](PluginConfig& c) { return IniRef(c.milkWench.intervalMinutes); }},
+    {"BWY_Wench_Milk", "ShowNotification", [](PluginConfig& c) { return IniRef(c.milkWench.showNotification); }},
+    {"BWY_Milk_Ethel", "Enabled", [](PluginConfig& c) { return IniRef(c.milkEthel.enabled); }},
+    {"BWY_Milk_Ethel", "ID", [](PluginConfig& c) { return IniRef(c.milkEthel.id); }},
+    {"BWY_Milk_Ethel", "PluginItem", [](PluginConfig& c) { return IniRef(c.milkEthel.pluginItem); }},
+    {"BWY_Milk_Ethel", "NPC", [](PluginConfig& c) { return IniRef(c.milkEthel.npc); }},
+    {"BWY_Milk_Ethel", "PluginNPC", [](PluginConfig& c) { return IniRef(c.milkEthel.pluginNPC); }},
+    {"BWY_Milk_Ethel", "Amount", [](PluginConfig& c) { return IniRef(c.milkEthel.amount); }},
+    {"BWY_Milk_Ethel", "IntervalMinutes", [](PluginConfig& c) { return IniRef(c.milkEthel.intervalMinutes); }},
+    {"BWY_Milk_Ethel", "ShowNotification", [](PluginConfig& c) { return IniRef(c.milkEthel.showNotification); }},
+    {"Frostfall", "Enabled", [](PluginConfig& c) { return IniRef(c.frostfall.enabled); }},
+    {"Frostfall", "ReductionAmount_Frost_ColdNeedValue", [](PluginConfig& c) { return IniRef(c.frostfall.reductionAmountCold); }},
+    {"Frostfall", "IntervalSeconds", [](PluginConfig& c) { return IniRef(c.frostfall.intervalSeconds); }},
+    {"Frostfall", "ActivationThreshold", [](PluginConfig& c) { return IniRef(c.frostfall.activationThreshold); }},
+    {"Frostfall", "ShowNotification", [](PluginConfig& c) { return IniRef(c.frostfall.showNotification); }},
+    {"Notification", "Enabled", [](PluginConfig& c) { return IniRef(c.notification.enabled); }},
+    {"OStimLog", "ResumeAtTail", [](PluginConfig& c) { return IniRef(c.ostimLog.resumeAtTail); }},
+    {"OStimLog", "ResumeScanKB", [](PluginConfig& c) { return IniRef(c.ostimLog.resumeScanKB); }},
+    {"OStimLog", "SliceLines", [](PluginConfig& c) { return IniRef(c.ostimLog.sliceLines); }},
+    {"OStimLog", "SliceMilliseconds", [](PluginConfig& c) { return IniRef(c.ostimLog.sliceMilliseconds); }}
+});
+
+inline constexpr auto kClimaxConfigSchema = MakeIniSchema<PluginConfigClimax>({
+    {"Gold", "Enabled", [](PluginConfigClimax& c) { return IniRef(c.gold.enabled); }},
+    {"Gold", "Amount", [](PluginConfigClimax& c) { return IniRef(c.gold.amount); }},
+    {"Gold", "EVENT", [](PluginConfigClimax& c) { return IniRef(c.gold.event); }},
+    {"Gold", "Male", [](PluginConfigClimax& c) { return IniRef(c.gold.male); }},
+    {"Gold", "Female", [](PluginConfigClimax& c) { return IniRef(c.gold.female); }},
+    {"Gold", "ShowNotification", [](PluginConfigClimax& c) { return IniRef(c.gold.showNotification); }},
+    {"Survival", "Enabled", [](PluginConfigClimax& c) { return IniRef(c.survival.enabled); }},
+    {"Survival", "ReductionAmount_HungerNeedValue", [](PluginConfigClimax& c) { return IniRef(c.survival.reductionAmountHunger); }},
+    {"Survival", "ReductionAmount_ColdNeedValue", [](PluginConfigClimax& c) { return IniRef(c.survival.reductionAmountCold); }},
+    {"Survival", "ReductionAmount_ExhaustionNeedValue", [](PluginConfigClimax& c) { return IniRef(c.survival.reductionAmountExhaustion); }},
+    {"Survival", "ActivationThreshold", [](PluginConfigClimax& c) { return IniRef(c.survival.activationThreshold); }},
+    {"Survival", "EVENT", [](PluginConfigClimax& c) { return IniRef(c.survival.event); }},
+    {"Survival", "Male", [](PluginConfigClimax& c) { return IniRef(c.survival.male); }},
+    {"Survival", "Female", [](PluginConfigClimax& c) { return IniRef(c.survival.female); }},
+    {"Survival", "ShowNotification", [](PluginConfigClimax& c) { return IniRef(c.survival.showNotification); }},
+    {"Attributes", "Enabled", [](PluginConfigClimax& c) { return IniRef(c.attributes.enabled); }},
+    {"Attributes", "RestorationAmount", [](PluginConfigClimax& c) { return IniRef(c.attributes.restorationAmount); }},
+    {"Attributes", "EVENT", [](PluginConfigClimax& c) { return IniRef(c.attributes.event); }},
+    {"Attributes", "Male", [](PluginConfigClimax& c) { return IniRef(c.attributes.male); }},
+    {"Attributes", "Female", [](PluginConfigClimax& c) { return IniRef(c.attributes.female); }},
+    {"Attributes", "ShowNotification", [](PluginConfigClimax& c) { return IniRef(c.attributes.showNotification); }},
+    {"Item1", "Enabled", [](PluginConfigClimax& c) { return IniRef(c.item1.enabled); }},
+    {"Item1", "ItemName", [](PluginConfigClimax& c) { return IniRef(c.item1.itemName); }},
+    {"Item1", "ID", [](PluginConfigClimax& c) { return IniRef(c.item1.id); }},
+    {"Item1", "Plugin", [](PluginConfigClimax& c) { return IniRef(c.item1.plugin); }},
+    {"Item1", "Amount", [](PluginConfigClimax& c) { return IniRef(c.item1.amount); }},
+    {"Item1", "EVENT", [](PluginConfigClimax& c) { return IniRef(c.item1.event); }},
+    {"Item1", "Male", [](PluginConfigClimax& c) { return IniRef(c.item1.male); }},
+    {"Item1", "Female", [](PluginConfigClimax& c) { return IniRef(c.item1.female); }},
+    {"Item1", "ShowNotification", [](PluginConfigClimax& c) { return IniRef(c.item1.showNotification); }},
+    {"Item2", "Enabled", [](PluginConfigClimax& c) { return IniRef(c.item2.enabled); }},
+    {"Item2", "ItemName", [](PluginConfigClimax& c) { return IniRef(c.item2.itemName); }},
+    {"Item2", "ID", [](PluginConfigClimax& c) { return IniRef(c.item2.id); }},
+    {"Item2", "Plugin", [](PluginConfigClimax& c) { return IniRef(c.item2.plugin); }},
+    {"Item2", "Amount", [](PluginConfigClimax& c) { return IniRef(c.item2.amount); }},
+    {"Item2", "EVENT", [](PluginConfigClimax& c) { return IniRef(c.item2.event); }},
+    {"Item2", "Male", [](PluginConfigClimax& c) { return IniRef(c.item2.male); }},
+    {"Item2", "Female", [](PluginConfigClimax& c) { return IniRef(c.item2.female); }},
+    {"Item2", "ShowNotification", [](PluginConfigClimax& c) { return IniRef(c.item2.showNotification); }},
+    {"Milk", "Enabled", [](PluginConfigClimax& c) { return IniRef(c.milk.enabled); }},
+    {"Milk", "ID", [](PluginConfigClimax& c) { return IniRef(c.milk.id); }},
+    {"Milk", "Plugin", [](PluginConfigClimax& c) { return IniRef(c.milk.plugin); }},
+    {"Milk", "Amount", [](PluginConfigClimax& c) { return IniRef(c.milk.amount); }},
+    {"Milk", "EVENT", [](PluginConfigClimax& c) { return IniRef(c.milk.event); }},
+    {"Milk", "Male", [](PluginConfigClimax& c) { return IniRef(c.milk.male); }},
+    {"Milk", "Female", [](PluginConfigClimax& c) { return IniRef(c.milk.female); }},
+    {"Milk", "ShowNotification", [](PluginConfigClimax& c) { return IniRef(c.milk.showNotification); }},
+    {"BWY_Wench_Milk", "Enabled", [](PluginConfigClimax& c) { return IniRef(c.milkWench.enabled); }},
+    {"BWY_Wench_Milk", "ID", [](PluginConfigClimax& c) { return IniRef(c.milkWench.id); }},
+    {"BWY_Wench_Milk", "Plugin", [](PluginConfigClimax& c) { return IniRef(c.milkWench.plugin); }},
+    {"BWY_Wench_Milk", "Amount", [](PluginConfigClimax& c) { return IniRef(c.milkWench.amount); }},
+    {"BWY_Wench_Milk", "EVENT", [](PluginConfigClimax& c) { return IniRef(c.milkWench.event); }},
+    {"BWY_Wench_Milk", "Male", [](PluginConfigClimax& c) { return IniRef(c.milkWench.male); }},
+    {"BWY_Wench_Milk", "Female", [](PluginConfigClimax& c) { return IniRef(c.milkWench.female); }},
+    {"BWY_Wench_Milk", "ShowNotification", [](PluginConfigClimax& c) { return IniRef(c.milkWench.showNotification); }},
+    {"BWY_Milk_Ethel", "Enabled", [](PluginConfigClimax& c) { return IniRef(c.milkEthel.enabled); }},
+    {"BWY_Milk_Ethel", "ID", [](PluginConfigClimax& c) { return IniRef(c.milkEthel.id); }},
+    {"BWY_Milk_Ethel", "PluginItem", [](PluginConfigClimax& c) { return IniRef(c.milkEthel.pluginItem); }},
+    {"BWY_Milk_Ethel", "NPC", [](PluginConfigClimax& c) { return IniRef(c.milkEthel.npc); }},
+    {"BWY_Milk_Ethel", "PluginNPC", [](PluginConfigClimax& c) { return IniRef(c.milkEthel.pluginNPC); }},
+    {"BWY_Milk_Ethel", "Amount", [](PluginConfigClimax& c) { return IniRef(c.milkEthel.amount); }},
+    {"BWY_Milk_Ethel", "EVENT", [](PluginConfigClimax& c) { return IniRef(c.milkEthel.event); }},
+    {"BWY_Milk_Ethel", "Male", [](PluginConfigClimax& c) { return IniRef(c.milkEthel.male); }},
+    {"BWY_Milk_Ethel", "Female", [](PluginConfigClimax& c) { return IniRef(c.milkEthel.female); }},
+    {"BWY_Milk_Ethel", "ShowNotification", [](PluginConfigClimax& c) { return IniRef(c.milkEthel.showNotification); }}
+});
+
+inline void ParsePluginConfigText(std::string_view text, PluginConfig& config) {
+    ParseIniText(text, kPluginConfigSchema, config);
+    config.rewards = ParseRewardSections(text);
+}
+
+inline std::string FormatPluginConfigText(const PluginConfig& config) {
+    std::string text = FormatIniText(kPluginConfigSchema, config);
+    AppendRewardSections(text, config.rewards);
+    return text;
+}
+
+// The fixed item sections of older INIs followed by every [Reward.*] section.
+inline std::vector<RewardDefinition> CollectRewardDefinitions(const PluginConfig& config) {
+    std::vector<RewardDefinition> rewards;
+
+    auto legacy = [&](const char* section, bool enabled, const std::string& itemName, const std::string& id,
+                      const std::string& plugin, int amount, int intervalMinutes, const char* requiresNearby,
+                      bool showNotification) {
+        rewards.push_back({section, enabled, itemName, id, plugin, amount, intervalMinutes, requiresNearby,
+                           showNotification});
+    };
+    legacy("Item1", config.item1.enabled, config.item1.itemName, config.item1.id, config.item1.plugin,
+           config.item1.amount, config.item1.intervalMinutes, "none", config.item1.showNotification);
+    legacy("Item2", config.item2.enabled, config.item2.itemName, config.item2.id, config.item2.plugin,
+           config.item2.amount, config.item2.intervalMinutes, "none", config.item2.showNotification);
+    legacy("Milk", config.milk.enabled, "Milk", config.milk.id, config.milk.plugin, config.milk.amount,
+           config.milk.intervalMinutes, "none", config.milk.showNotification);
+    legacy("BWY_Wench_Milk", config.milkWench.enabled, "Wench Milk", config.milkWench.id, config.milkWench.plugin,
+           config.milkWench.amount, config.milkWench.intervalMinutes, "Wench", config.milkWench.showNotification);
+    legacy("BWY_Milk_Ethel", config.milkEthel.enabled, "Milk Ethel", config.milkEthel.id, config.milkEthel.pluginItem,
+           config.milkEthel.amount, config.milkEthel.intervalMinutes, "Ethel", config.milkEthel.showNotification);
+
+    rewards.insert(rewards.end(), config.rewards.begin(), config.rewards.end());
+    return rewards;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Load-order slot of one plugin, expressed the way FormIDs are tested against it. Regular
+// plugins own the top byte (0xXX000000, 24-bit local IDs); light plugins share the 0xFE slot
+// and own the next 12 bits (0xFEXXX000, 12-bit local IDs).
+struct PluginIndex {
+    bool present = false;
+    bool light = false;
+    std::uint32_t prefix = 0;
+    std::uint32_t localMask = 0;
+
+    static constexpr PluginIndex Regular(std::uint8_t compileIndex) {
+        return {true, false, static_cast<std::uint32_t>(compileIndex) << 24, 0x00FFFFFFu};
+    }
+
+    static constexpr PluginIndex Light(std::uint16_t smallFileCompileIndex) {
+        return {true, true, 0xFE000000u | (static_cast<std::uint32_t>(smallFileCompileIndex & 0xFFF) << 12), 0x00000FFFu};
+    }
+
+    constexpr bool Contains(std::uint32_t formID) const {
+        return present && (formID & ~localMask) == prefix;
+    }
+
+    // Full FormID for an ID as written in the plugin (or in the INI, without the load order).
+    constexpr std::uint32_t Compose(std::uint32_t localID) const {
+        return prefix | (localID & localMask);
+    }
+};
+
+// Plugins the configuration refers to, resolved once after the data files are loaded. Absent
+// plugins are kept too, so asking again does not go back to the data handler.
+class PluginIndexTable {
+public:
+    const PluginIndex* Find(std::string_view name) const {
+        for (const auto& entry : _entries) {
+            if (entry.name == name) {
+                return &entry.index;
+            }
+        }
+        return nullptr;
+    }
+
+    void Set(std::string_view name, PluginIndex index) {
+        for (auto& entry : _entries) {
+            if (entry.name == name) {
+                entry.index = index;
+                return;
+            }
+        }
+        _entries.push_back({std::string(name), index});
+    }
+
+    std::size_t Size() const { return _entries.size(); }
+
+private:
+    struct Entry {
+        std::string name;
+        PluginIndex index;
+    };
+
+    std::vector<Entry> _entries;
+};
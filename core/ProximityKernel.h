@@ -0,0 +1,75 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OSURVIVAL_PROXIMITY_SSE2 1
+#endif
+
+// Band classification for a column of positions: bit k of masks[i] is set when point i lies
+// within radius k of the origin. Everything runs on squared distances and all bands are
+// decided in the same pass, so one sweep answers the 500/1000/3000 style checks together.
+constexpr std::size_t kProximityBands = 4;
+
+struct ProximityLimits {
+    // Squared radii; a negative limit disables the band.
+    std::array<float, kProximityBands> squared{-1.0f, -1.0f, -1.0f, -1.0f};
+};
+
+inline void ComputeProximityBandsScalar(const float* x, const float* y, const float* z, std::size_t count,
+                                        float originX, float originY, float originZ,
+                                        const ProximityLimits& limits, std::uint8_t* masks,
+                                        std::size_t first = 0) {
+    for (std::size_t i = first; i < count; i++) {
+        float dx = x[i] - originX;
+        float dy = y[i] - originY;
+        float dz = z[i] - originZ;
+        float d2 = dx * dx + dy * dy + dz * dz;
+
+        std::uint8_t mask = 0;
+        for (std::size_t k = 0; k < kProximityBands; k++) {
+            mask |= static_cast<std::uint8_t>((d2 <= limits.squared[k]) << k);
+        }
+        masks[i] = mask;
+    }
+}
+
+inline void ComputeProximityBands(const float* x, const float* y, const float* z, std::size_t count,
+                                  float originX, float originY, float originZ,
+                                  const ProximityLimits& limits, std::uint8_t* masks) {
+#ifdef OSURVIVAL_PROXIMITY_SSE2
+    const __m128 ox = _mm_set1_ps(originX);
+    const __m128 oy = _mm_set1_ps(originY);
+    const __m128 oz = _mm_set1_ps(originZ);
+    __m128 limit[kProximityBands];
+    __m128i bit[kProximityBands];
+    for (std::size_t k = 0; k < kProximityBands; k++) {
+        limit[k] = _mm_set1_ps(limits.squared[k]);
+        bit[k] = _mm_set1_epi32(1 << k);
+    }
+
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), ox);
+        __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), oy);
+        __m128 dz = _mm_sub_ps(_mm_loadu_ps(z + i), oz);
+        __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+        // Each comparison is all-ones per lane; keep that lane's band bit and narrow to bytes.
+        __m128i lanes = _mm_setzero_si128();
+        for (std::size_t k = 0; k < kProximityBands; k++) {
+            lanes = _mm_or_si128(lanes, _mm_and_si128(_mm_castps_si128(_mm_cmple_ps(d2, limit[k])), bit[k]));
+        }
+        __m128i words = _mm_packs_epi32(lanes, lanes);
+        int packed = _mm_cvtsi128_si32(_mm_packus_epi16(words, words));
+        std::memcpy(masks + i, &packed, 4);
+    }
+    ComputeProximityBandsScalar(x, y, z, count, originX, originY, originZ, limits, masks, i);
+#else
+    ComputeProximityBandsScalar(x, y, z, count, originX, originY, originZ, limits, masks);
+#endif
+}
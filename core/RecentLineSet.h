@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Remembers the last Capacity line hashes without allocating. Lookups go through an
+// open-addressed table twice the capacity with linear probing; once full, inserting a
+// new hash evicts the oldest one from the insertion ring instead of wiping everything.
+template <std::size_t Capacity>
+class RecentLineSet {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    bool Contains(std::uint64_t hash) const {
+        return FindSlot(Normalize(hash)) != kNotFound;
+    }
+
+    // Returns false when the hash was already present.
+    bool Insert(std::uint64_t hash) {
+        hash = Normalize(hash);
+        if (FindSlot(hash) != kNotFound) {
+            return false;
+        }
+
+        if (_size == Capacity) {
+            EraseSlot(FindSlot(_ring[_head]));
+            _head = (_head + 1) & (Capacity - 1);
+            _size--;
+        }
+
+        std::size_t slot = Home(hash);
+        while (_slots[slot] != kEmpty) {
+            slot = (slot + 1) & kMask;
+        }
+        _slots[slot] = hash;
+
+        _ring[(_head + _size) & (Capacity - 1)] = hash;
+        _size++;
+        return true;
+    }
+
+    void Clear() {
+        _slots.fill(kEmpty);
+        _head = 0;
+        _size = 0;
+    }
+
+    std::size_t Size() const { return _size; }
+    static constexpr std::size_t GetCapacity() { return Capacity; }
+
+private:
+    static constexpr std::size_t kSlotCount = Capacity * 2;
+    static constexpr std::size_t kMask = kSlotCount - 1;
+    static constexpr std::size_t kNotFound = static_cast<std::size_t>(-1);
+    static constexpr std::uint64_t kEmpty = 0;
+
+    static std::uint64_t Normalize(std::uint64_t hash) { return hash == kEmpty ? 1 : hash; }
+
+    static std::size_t Home(std::uint64_t hash) {
+        return static_cast<std::size_t>((hash * 0x9E3779B97F4A7C15ull) >> 32) & kMask;
+    }
+
+    std::size_t FindSlot(std::uint64_t hash) const {
+        std::size_t slot = Home(hash);
+        while (_slots[slot] != kEmpty) {
+            if (_slots[slot] == hash) {
+                return slot;
+            }
+            slot = (slot + 1) & kMask;
+        }
+        return kNotFound;
+    }
+
+    // Backward-shift deletion keeps every probe chain contiguous without tombstones.
+    void EraseSlot(std::size_t hole) {
+        std::size_t next = hole;
+        for (;;) {
+            next = (next + 1) & kMask;
+            if (_slots[next] == kEmpty) {
+                break;
+            }
+            std::size_t home = Home(_slots[next]);
+            bool homeBetween = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+            if (homeBetween) {
+                continue;
+            }
+            _slots[hole] = _slots[next];
+            hole = next;
+        }
+        _slots[hole] = kEmpty;
+    }
+
+    std::array<std::uint64_t, kSlotCount> _slots{};
+    std::array<std::uint64_t, Capacity> _ring{};
+    std::size_t _head = 0;
+    std::size_t _size = 0;
+};
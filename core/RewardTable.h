@@ -0,0 +1,138 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "IniSchema.h"
+
+// What must hold, besides being in a scene, for an interval reward to be issued.
+enum class RewardCondition : std::uint8_t {
+    kNone,
+    kWenchNearby,
+    kEthelNearby,
+    kInvalid
+};
+
+inline RewardCondition ParseRewardCondition(std::string_view text) {
+    if (text.empty() || text == "none") {
+        return RewardCondition::kNone;
+    }
+    if (text == "Wench") {
+        return RewardCondition::kWenchNearby;
+    }
+    if (text == "Ethel") {
+        return RewardCondition::kEthelNearby;
+    }
+    return RewardCondition::kInvalid;
+}
+
+// One [Reward.<name>] section of the INI.
+struct RewardDefinition {
+    std::string name;
+    bool enabled = true;
+    std::string itemName = "none";
+    std::string id = "xxxxxx";
+    std::string plugin = "none";
+    int amount = 1;
+    int intervalMinutes = 1;
+    std::string requiresNearby = "none";
+    bool showNotification = true;
+};
+
+inline constexpr std::string_view kRewardSectionPrefix = "Reward.";
+
+inline constexpr auto kRewardSectionSchema = MakeIniSchema<RewardDefinition>({
+    {"", "Enabled", [](RewardDefinition& r) { return IniRef(r.enabled); }},
+    {"", "ItemName", [](RewardDefinition& r) { return IniRef(r.itemName); }},
+    {"", "ID", [](RewardDefinition& r) { return IniRef(r.id); }},
+    {"", "Plugin", [](RewardDefinition& r) { return IniRef(r.plugin); }},
+    {"", "Amount", [](RewardDefinition& r) { return IniRef(r.amount); }},
+    {"", "IntervalMinutes", [](RewardDefinition& r) { return IniRef(r.intervalMinutes); }},
+    {"", "RequiresNearby", [](RewardDefinition& r) { return IniRef(r.requiresNearby); }},
+    {"", "ShowNotification", [](RewardDefinition& r) { return IniRef(r.showNotification); }}
+});
+
+inline std::vector<RewardDefinition> ParseRewardSections(std::string_view text) {
+    std::vector<RewardDefinition> rewards;
+    ParseIniSections(text, kRewardSectionPrefix, kRewardSectionSchema, [&](std::string_view name) {
+        rewards.push_back({});
+        rewards.back().name = name;
+        return &rewards.back();
+    });
+    return rewards;
+}
+
+inline void AppendRewardSections(std::string& text, const std::vector<RewardDefinition>& rewards) {
+    for (const auto& reward : rewards) {
+        AppendIniSection(text, std::string(kRewardSectionPrefix) + reward.name, kRewardSectionSchema, reward);
+    }
+}
+
+// Interval item rewards with their items already resolved, so a tick only compares times.
+// Item is the game's bound-object type; the table never dereferences it. Owned by the
+// monitor thread.
+template <class Item>
+class RewardTable {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        std::string label;
+        Item* item = nullptr;
+        int amount = 0;
+        Clock::duration interval{};
+        RewardCondition condition = RewardCondition::kNone;
+        bool showNotification = false;
+        Clock::time_point last{};
+    };
+
+    void Add(Entry entry) { _entries.push_back(std::move(entry)); }
+
+    void Clear() { _entries.clear(); }
+
+    bool Empty() const { return _entries.empty(); }
+    std::size_t Size() const { return _entries.size(); }
+    const std::vector<Entry>& Entries() const { return _entries; }
+
+    // Scene start: every interval counts from now.
+    void Restart(Clock::time_point now) {
+        for (auto& entry : _entries) {
+            entry.last = now;
+        }
+    }
+
+    // Collects every reward that is due and whose condition holds, marks them issued and
+    // hands them to issue(due) in table order, once per tick. Returns how many were due.
+    template <class Holds, class Issue>
+    std::size_t IssueDue(Clock::time_point now, Holds&& holds, Issue&& issue) {
+        _due.clear();
+        for (auto& entry : _entries) {
+            if (now - entry.last >= entry.interval && holds(entry.condition)) {
+                entry.last = now;
+                _due.push_back(&entry);
+            }
+        }
+        if (!_due.empty()) {
+            issue(_due);
+        }
+        return _due.size();
+    }
+
+    // Earliest time any reward becomes due; Clock::time_point::max() when the table is empty.
+    Clock::time_point NextDue() const {
+        Clock::time_point next = Clock::time_point::max();
+        for (const auto& entry : _entries) {
+            next = std::min(next, entry.last + entry.interval);
+        }
+        return next;
+    }
+
+private:
+    std::vector<Entry> _entries;
+    std::vector<const Entry*> _due;
+};
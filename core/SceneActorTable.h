@@ -0,0 +1,210 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Actors around the player for the current OStim scene, captured once at scene start.
+// Rows live in one flat vector; names (and race names) are interned so a row is a handful
+// of integers, and open-addressed indices resolve a normalized name, a reference FormID or
+// a base FormID to a row without walking the game's actor lists again.
+//
+// The table also remembers which names the OStim log has announced for this scene and
+// which of them were confirmed close to the player, replacing the separate name list and
+// name->refID map.
+class SceneActorTable {
+public:
+    static constexpr std::uint32_t kNone = 0xFFFFFFFFu;
+
+    struct Actor {
+        std::uint32_t name = kNone;
+        std::uint32_t race = kNone;
+        std::uint32_t refID = 0;
+        std::uint32_t baseID = 0;
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+        bool isFemale = false;
+        bool isVampire = false;
+        bool isWerewolf = false;
+    };
+
+    // Drops the actors but keeps what the log announced, for rebuilding at scene start.
+    void ClearActors() {
+        _actors.clear();
+        _refIndex.Clear();
+        _baseIndex.Clear();
+        for (auto& entry : _names) {
+            entry.actor = kNone;
+        }
+    }
+
+    void Clear() {
+        ClearActors();
+        _names.clear();
+        _nameIndex.Clear();
+        _detected.clear();
+    }
+
+    bool Empty() const { return _actors.empty(); }
+    std::size_t Size() const { return _actors.size(); }
+    const std::vector<Actor>& Actors() const { return _actors; }
+
+    // Adds an actor under its normalized name. A later actor with the same name takes over
+    // the name; the FormID indices keep pointing at the first row with that FormID.
+    void Add(std::string_view name, std::string_view race, Actor actor) {
+        actor.name = Intern(name);
+        actor.race = Intern(race);
+
+        auto row = static_cast<std::uint32_t>(_actors.size());
+        _actors.push_back(actor);
+        _names[actor.name].actor = row;
+
+        if (!FindByRefID(actor.refID)) {
+            _refIndex.Insert(HashFormID(actor.refID), row);
+        }
+        if (!FindByBaseID(actor.baseID)) {
+            _baseIndex.Insert(HashFormID(actor.baseID), row);
+        }
+    }
+
+    const Actor* FindByName(std::string_view name) const {
+        std::uint32_t id = FindName(name);
+        return id == kNone || _names[id].actor == kNone ? nullptr : &_actors[_names[id].actor];
+    }
+
+    const Actor* FindByRefID(std::uint32_t refID) const {
+        std::uint32_t row = _refIndex.Find(HashFormID(refID), [&](std::uint32_t r) { return _actors[r].refID == refID; });
+        return row == kNone ? nullptr : &_actors[row];
+    }
+
+    const Actor* FindByBaseID(std::uint32_t baseID) const {
+        std::uint32_t row = _baseIndex.Find(HashFormID(baseID), [&](std::uint32_t r) { return _actors[r].baseID == baseID; });
+        return row == kNone ? nullptr : &_actors[row];
+    }
+
+    std::string_view Name(std::uint32_t id) const { return id == kNone ? std::string_view{} : _names[id].text; }
+
+    // Records a name announced by the log; false if it was already announced this scene.
+    bool MarkDetected(std::string_view name) {
+        std::uint32_t id = Intern(name);
+        if (_names[id].detected) {
+            return false;
+        }
+        _names[id].detected = true;
+        _detected.push_back(id);
+        return true;
+    }
+
+    bool HasDetected() const { return !_detected.empty(); }
+    const std::vector<std::uint32_t>& Detected() const { return _detected; }
+
+    // FormID confirmed for an announced name once it was seen near the player, 0 if not yet.
+    std::uint32_t ResolvedRefID(std::uint32_t id) const { return _names[id].resolvedRefID; }
+    void SetResolvedRefID(std::uint32_t id, std::uint32_t refID) { _names[id].resolvedRefID = refID; }
+
+    const Actor* ActorForName(std::uint32_t id) const {
+        return _names[id].actor == kNone ? nullptr : &_actors[_names[id].actor];
+    }
+
+private:
+    struct NameEntry {
+        std::string text;
+        std::uint32_t actor = kNone;
+        std::uint32_t resolvedRefID = 0;
+        bool detected = false;
+    };
+
+    // Open-addressed hash -> row map with linear probing. Rows are only ever added and the
+    // whole index is dropped with the scene, so no deletion is needed.
+    class RowIndex {
+    public:
+        void Clear() {
+            _slots.clear();
+            _count = 0;
+        }
+
+        template <class Matches>
+        std::uint32_t Find(std::uint64_t hash, Matches&& matches) const {
+            if (_slots.empty()) {
+                return kNone;
+            }
+            std::size_t mask = _slots.size() - 1;
+            for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+                const Slot& slot = _slots[i];
+                if (slot.row == kNone) {
+                    return kNone;
+                }
+                if (slot.hash == hash && matches(slot.row)) {
+                    return slot.row;
+                }
+            }
+        }
+
+        void Insert(std::uint64_t hash, std::uint32_t row) {
+            if ((_count + 1) * 2 > _slots.size()) {
+                Grow();
+            }
+            Place(hash, row);
+            _count++;
+        }
+
+    private:
+        struct Slot {
+            std::uint64_t hash = 0;
+            std::uint32_t row = kNone;
+        };
+
+        void Place(std::uint64_t hash, std::uint32_t row) {
+            std::size_t mask = _slots.size() - 1;
+            std::size_t i = hash & mask;
+            while (_slots[i].row != kNone) {
+                i = (i + 1) & mask;
+            }
+            _slots[i] = {hash, row};
+        }
+
+        void Grow() {
+            std::size_t capacity = _slots.empty() ? 16 : _slots.size() * 2;
+            std::vector<Slot> old = std::move(_slots);
+            _slots.assign(capacity, Slot{});
+            for (const auto& slot : old) {
+                if (slot.row != kNone) {
+                    Place(slot.hash, slot.row);
+                }
+            }
+        }
+
+        std::vector<Slot> _slots;
+        std::size_t _count = 0;
+    };
+
+    static std::uint64_t HashFormID(std::uint32_t formID) { return formID * 0x9E3779B97F4A7C15ull >> 7; }
+    static std::uint64_t HashName(std::string_view name) { return std::hash<std::string_view>{}(name); }
+
+    std::uint32_t FindName(std::string_view name) const {
+        return _nameIndex.Find(HashName(name), [&](std::uint32_t id) { return _names[id].text == name; });
+    }
+
+    std::uint32_t Intern(std::string_view name) {
+        std::uint32_t id = FindName(name);
+        if (id != kNone) {
+            return id;
+        }
+        id = static_cast<std::uint32_t>(_names.size());
+        _names.push_back(NameEntry{std::string(name)});
+        _nameIndex.Insert(HashName(name), id);
+        return id;
+    }
+
+    std::vector<Actor> _actors;
+    std::deque<NameEntry> _names;
+    std::vector<std::uint32_t> _detected;
+    RowIndex _nameIndex;
+    RowIndex _refIndex;
+    RowIndex _baseIndex;
+};
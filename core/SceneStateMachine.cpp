@@ -0,0 +1,112 @@
+#include "SceneStateMachine.h"
+
+SceneStateMachine::Step SceneStateMachine::Apply(const OStimEvent& event) {
+    Step step;
+
+    switch (event.kind) {
+        case OStimEventKind::kSpeedChange:
+            if (event.speed != _speed) {
+                _speed = event.speed;
+                step.speedChanged = true;
+            }
+            break;
+
+        case OStimEventKind::kSceneEnd:
+            if (_inScene) {
+                _inScene = false;
+                step.ended = true;
+            }
+            break;
+
+        case OStimEventKind::kNodeChange:
+            if (!event.node.empty() && event.node != _animation) {
+                _animation.assign(event.node);
+                step.animationChanged = true;
+                if (!_inScene) {
+                    _inScene = true;
+                    _speed = 0;
+                    step.started = true;
+                }
+            }
+            if (event.resetsSpeed) {
+                _speed = 0;
+                step.speedReset = true;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return step;
+}
+
+bool SceneStateMachine::ClearAnimation() {
+    bool had = !_animation.empty();
+    _animation.clear();
+    return had;
+}
+
+void SceneStateMachine::Reset() {
+    _animation.clear();
+    _inScene = false;
+    _speed = 0;
+}
+
+SceneStateMachine::Step SceneStateMachine::Restore(std::string_view animation, int speed) {
+    Step step;
+    if (animation.empty()) {
+        return step;
+    }
+
+    step.started = !_inScene;
+    step.animationChanged = animation != _animation;
+    step.speedChanged = speed != _speed;
+    _inScene = true;
+    _animation.assign(animation);
+    _speed = speed;
+    return step;
+}
+
+bool SceneResumeScan::Feed(std::string_view line) {
+    if (_settled) {
+        return false;
+    }
+    _lines++;
+
+    OStimEvent event = ParseOStimEvent(line);
+    switch (event.kind) {
+        case OStimEventKind::kSpeedChange:
+            if (!_speedKnown) {
+                _speed = event.speed;
+                _speedKnown = true;
+            }
+            break;
+
+        case OStimEventKind::kNodeChange:
+            if (event.resetsSpeed && !_speedKnown) {
+                _speed = 0;
+                _speedKnown = true;
+            }
+            if (!event.node.empty() && _animation.empty()) {
+                _animation.assign(event.node);
+            }
+            break;
+
+        case OStimEventKind::kSceneEnd:
+            // Either no scene followed this end, or the one that did started at speed 0.
+            if (!_speedKnown || _animation.empty()) {
+                _speed = 0;
+            }
+            _settled = true;
+            break;
+
+        default:
+            break;
+    }
+
+    if (!_animation.empty() && _speedKnown) {
+        _settled = true;
+    }
+    return !_settled;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "OStimEventParser.h"
+
+// The OStim scene rules, applied to parsed OStim.log events without any game calls: a node
+// change starts a scene when none is running, a closing or stopping thread ends it, and the
+// speed level follows speed changes and drops back to 0 on every node change. Apply() reports
+// what changed so the caller can react (rewards, NPC capture, logging). Orgasm and voice-set
+// events do not change the scene and are left to the caller.
+class SceneStateMachine {
+public:
+    struct Step {
+        bool started = false;
+        bool ended = false;
+        bool animationChanged = false;
+        bool speedChanged = false;
+        bool speedReset = false;
+    };
+
+    Step Apply(const OStimEvent& event);
+
+    // OStim.log was truncated or replaced: the current animation no longer applies, though a
+    // running scene only ends once its end is logged. Returns whether there was one.
+    bool ClearAnimation();
+
+    // No scene, no animation, speed 0.
+    void Reset();
+
+    // Enters the scene found at the end of OStim.log (see SceneResumeScan) without replaying the
+    // lines that led there. Reports the change like Apply() would; an empty animation is no scene.
+    Step Restore(std::string_view animation, int speed);
+
+    bool InScene() const { return _inScene; }
+    const std::string& Animation() const { return _animation; }
+    int Speed() const { return _speed; }
+
+    // In a scene with a known animation: what the interval rewards and restorations wait for.
+    bool IsActive() const { return _inScene && !_animation.empty(); }
+
+private:
+    std::string _animation;
+    bool _inScene = false;
+    int _speed = 0;
+};
+
+// The scene state at the end of OStim.log, rebuilt from its last lines fed newest first, so the
+// log can be picked up at its tail instead of being replayed from the start. The newest named
+// node is the animation unless a scene end is newer still; the speed is the newest speed change
+// unless a node change that resets it is newer. Anything older than the scene's start, or than
+// both answers, cannot change the result.
+class SceneResumeScan {
+public:
+    // Takes the next older line. False once older lines can no longer change the result.
+    bool Feed(std::string_view line);
+
+    bool Settled() const { return _settled; }
+    bool InScene() const { return !_animation.empty(); }
+    const std::string& Animation() const { return _animation; }
+    int Speed() const { return _speed; }
+    std::uint64_t Lines() const { return _lines; }
+
+private:
+    std::string _animation;
+    int _speed = 0;
+    bool _speedKnown = false;
+    bool _settled = false;
+    std::uint64_t _lines = 0;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+// Bounded lock-free ring for exactly one producer thread and one consumer thread. Each side
+// owns its index and only publishes it; a cached copy of the other side's index means the
+// shared cache line is read only when the ring looks full (producer) or empty (consumer).
+template <class T, std::size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    SpscQueue() : _cells(std::make_unique<T[]>(Capacity)) {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer side only. Leaves value untouched when the ring is full.
+    bool TryPush(T&& value) {
+        std::size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _headCache == Capacity) {
+            _headCache = _head.load(std::memory_order_acquire);
+            if (tail - _headCache == Capacity) {
+                return false;
+            }
+        }
+
+        _cells[tail & kMask] = std::move(value);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side only.
+    bool TryPop(T& value) {
+        std::size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tailCache) {
+            _tailCache = _tail.load(std::memory_order_acquire);
+            if (head == _tailCache) {
+                return false;
+            }
+        }
+
+        value = std::move(_cells[head & kMask]);
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // A snapshot from either side.
+    std::size_t Size() const {
+        std::size_t head = _head.load(std::memory_order_acquire);
+        return _tail.load(std::memory_order_acquire) - head;
+    }
+
+    // Only while neither the producer nor the consumer is running.
+    void Clear() {
+        T value;
+        while (TryPop(value)) {
+        }
+    }
+
+private:
+    static constexpr std::size_t kMask = Capacity - 1;
+
+    std::unique_ptr<T[]> _cells;
+    alignas(64) std::atomic<std::size_t> _head{0};
+    std::size_t _tailCache = 0;
+    alignas(64) std::atomic<std::size_t> _tail{0};
+    std::size_t _headCache = 0;
+};
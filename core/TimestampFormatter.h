@@ -0,0 +1,127 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+
+// Formats "YYYY-MM-DD HH:MM:SS" and "YYYY-MM-DD HH:MM:SS.mmm" into a caller buffer.
+// The date/time part only changes once per second, so it is cached behind a seqlock and
+// each call just copies it and patches in the milliseconds. Readers never block: if the
+// cache is being replaced or holds another second they format locally and try to
+// publish their result.
+class TimestampFormatter {
+public:
+    static constexpr std::size_t kSecondsLength = 19;
+    static constexpr std::size_t kMillisLength = 23;
+
+    static TimestampFormatter& GetSingleton() {
+        static TimestampFormatter singleton;
+        return singleton;
+    }
+
+    static void ToLocalTime(std::time_t time, std::tm& out) {
+#ifdef _WIN32
+        localtime_s(&out, &time);
+#else
+        localtime_r(&time, &out);
+#endif
+    }
+
+    // Writes kSecondsLength characters, no terminator.
+    std::size_t FormatSeconds(std::chrono::system_clock::time_point time, char* out) {
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+        CopySeconds(FloorDiv(ms, 1000), out);
+        return kSecondsLength;
+    }
+
+    // Writes kMillisLength characters, no terminator.
+    std::size_t FormatMillis(std::chrono::system_clock::time_point time, char* out) {
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+        std::int64_t seconds = FloorDiv(ms, 1000);
+        auto millis = static_cast<int>(ms - seconds * 1000);
+
+        CopySeconds(seconds, out);
+        out[19] = '.';
+        out[20] = static_cast<char>('0' + millis / 100);
+        out[21] = static_cast<char>('0' + millis / 10 % 10);
+        out[22] = static_cast<char>('0' + millis % 10);
+        return kMillisLength;
+    }
+
+private:
+    // The cached text is stored as whole words so concurrent readers never race on
+    // plain memory; a torn read is caught by the sequence check and discarded.
+    static constexpr std::size_t kWords = (kSecondsLength + 7) / 8;
+
+    TimestampFormatter() = default;
+
+    static std::int64_t FloorDiv(std::int64_t value, std::int64_t divisor) {
+        std::int64_t quotient = value / divisor;
+        return (value % divisor < 0) ? quotient - 1 : quotient;
+    }
+
+    static void WriteDigits(char* out, int value, int width) {
+        for (int i = width - 1; i >= 0; i--) {
+            out[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+    }
+
+    static void FormatUncached(std::int64_t seconds, char* out) {
+        std::tm local{};
+        ToLocalTime(static_cast<std::time_t>(seconds), local);
+        WriteDigits(out, local.tm_year + 1900, 4);
+        out[4] = '-';
+        WriteDigits(out + 5, local.tm_mon + 1, 2);
+        out[7] = '-';
+        WriteDigits(out + 8, local.tm_mday, 2);
+        out[10] = ' ';
+        WriteDigits(out + 11, local.tm_hour, 2);
+        out[13] = ':';
+        WriteDigits(out + 14, local.tm_min, 2);
+        out[16] = ':';
+        WriteDigits(out + 17, local.tm_sec, 2);
+    }
+
+    void CopySeconds(std::int64_t seconds, char* out) {
+        std::array<std::uint64_t, kWords> words;
+
+        std::uint64_t before = _sequence.load(std::memory_order_acquire);
+        if ((before & 1) == 0) {
+            std::int64_t cachedSeconds = _seconds.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < kWords; i++) {
+                words[i] = _text[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (cachedSeconds == seconds && _sequence.load(std::memory_order_relaxed) == before) {
+                std::memcpy(out, words.data(), kSecondsLength);
+                return;
+            }
+        }
+
+        char text[kWords * 8] = {};
+        FormatUncached(seconds, text);
+        std::memcpy(out, text, kSecondsLength);
+
+        // Publish only if nobody else is; losing the race just means formatting again.
+        if ((before & 1) == 0 &&
+            _sequence.compare_exchange_strong(before, before + 1, std::memory_order_acquire)) {
+            // Keeps the data stores below from becoming visible ahead of the odd sequence.
+            std::atomic_thread_fence(std::memory_order_release);
+            std::memcpy(words.data(), text, sizeof(text));
+            _seconds.store(seconds, std::memory_order_relaxed);
+            for (std::size_t i = 0; i < kWords; i++) {
+                _text[i].store(words[i], std::memory_order_relaxed);
+            }
+            _sequence.store(before + 2, std::memory_order_release);
+        }
+    }
+
+    std::atomic<std::uint64_t> _sequence{0};
+    std::atomic<std::int64_t> _seconds{INT64_MIN};
+    std::array<std::atomic<std::uint64_t>, kWords> _text{};
+};
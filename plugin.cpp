@@ -5,21 +5,39 @@
 #include <windows.h>
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
-#include <ctime>
-#include <deque>
 #include <filesystem>
-#include <fstream>
 #include <iomanip>
 #include <map>
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <thread>
-#include <unordered_set>
 #include <vector>
 
+#include "core/ActorSnapshot.h"
+#include "core/AsyncLogSink.h"
+#include "core/ConfigSnapshot.h"
+#include "core/DeadlineScheduler.h"
+#include "core/DirectoryWatcher.h"
+#include "core/EffectQueue.h"
+#include "core/IniSchema.h"
+#include "core/NeedsProvider.h"
+#include "core/OStimEventParser.h"
+#include "core/OStimLineClassifier.h"
+#include "core/OStimLineFilter.h"
+#include "core/OStimLogTailer.h"
+#include "core/PluginConfig.h"
+#include "core/PluginIndexTable.h"
+#include "core/RewardTable.h"
+#include "core/SceneActorTable.h"
+#include "core/SceneStateMachine.h"
+#include "core/SpscQueue.h"
+#include "core/TimestampFormatter.h"
+
 namespace fs = std::filesystem;
 namespace logger = SKSE::log;
 
@@ -28,176 +46,6 @@ struct SKSELogsPaths {
     fs::path secondary;
 };
 
-struct PluginConfig {
-    struct {
-        bool enabled = true;
-        int amount = 300;
-        int intervalMinutes = 7;
-        bool showNotification = true;
-    } gold;
-
-    struct {
-        bool enabled = true;
-        int reductionAmountHunger = 100;
-        int reductionAmountCold = 100;
-        int reductionAmountExhaustion = 100;
-        int intervalSeconds = 60;
-        int activationThreshold = 100;
-        bool showNotification = true;
-    } survival;
-
-    struct {
-        bool enabled = true;
-        int restorationAmount = 50;
-        int intervalSeconds = 120;
-        bool showNotification = true;
-    } attributes;
-
-    struct {
-        bool enabled = false;
-        std::string itemName = "none";
-        std::string id = "xxxxxx";
-        std::string plugin = "none";
-        int amount = 1;
-        int intervalMinutes = 1;
-        bool showNotification = true;
-    } item1;
-
-    struct {
-        bool enabled = false;
-        std::string itemName = "none";
-        std::string id = "xxxxxx";
-        std::string plugin = "none";
-        int amount = 1;
-        int intervalMinutes = 1;
-        bool showNotification = true;
-    } item2;
-
-    struct {
-        bool enabled = true;
-        std::string id = "003534";
-        std::string plugin = "Dawnguard.esm";
-        int amount = 3;
-        int intervalMinutes = 3;
-        bool showNotification = true;
-    } milk;
-
-    struct {
-        bool enabled = true;
-        std::string id = "000D73";
-        std::string plugin = "YurianaWench.esp";
-        int amount = 3;
-        int intervalMinutes = 3;
-        bool showNotification = true;
-    } milkWench;
-
-    struct {
-        bool enabled = true;
-        std::string id = "65FEC3";
-        std::string pluginItem = "YurianaWench.esp";
-        std::string npc = "576A03";
-        std::string pluginNPC = "YurianaWench.esp";
-        int amount = 1;
-        int intervalMinutes = 3;
-        bool showNotification = true;
-    } milkEthel;
-
-    struct {
-        bool enabled = true;
-    } notification;
-};
-
-struct PluginConfigClimax {
-    struct {
-        bool enabled = true;
-        int amount = 300;
-        std::string event = "ostim_actor_orgasm";
-        bool male = true;
-        bool female = true;
-        bool showNotification = true;
-    } gold;
-
-    struct {
-        bool enabled = true;
-        int reductionAmountHunger = 100;
-        int reductionAmountCold = 100;
-        int reductionAmountExhaustion = 100;
-        int activationThreshold = 100;
-        std::string event = "ostim_actor_orgasm";
-        bool male = true;
-        bool female = true;
-        bool showNotification = true;
-    } survival;
-
-    struct {
-        bool enabled = true;
-        int restorationAmount = 50;
-        std::string event = "ostim_actor_orgasm";
-        bool male = true;
-        bool female = true;
-        bool showNotification = true;
-    } attributes;
-
-    struct {
-        bool enabled = false;
-        std::string itemName = "none";
-        std::string id = "xxxxxx";
-        std::string plugin = "none";
-        int amount = 1;
-        std::string event = "ostim_actor_orgasm";
-        bool male = true;
-        bool female = true;
-        bool showNotification = true;
-    } item1;
-
-    struct {
-        bool enabled = false;
-        std::string itemName = "none";
-        std::string id = "xxxxxx";
-        std::string plugin = "none";
-        int amount = 1;
-        std::string event = "ostim_actor_orgasm";
-        bool male = true;
-        bool female = true;
-        bool showNotification = true;
-    } item2;
-
-    struct {
-        bool enabled = false;
-        std::string id = "003534";
-        std::string plugin = "HearthFires.esm";
-        int amount = 1;
-        std::string event = "ostim_actor_orgasm";
-        bool male = true;
-        bool female = true;
-        bool showNotification = true;
-    } milk;
-
-    struct {
-        bool enabled = false;
-        std::string id = "000D73";
-        std::string plugin = "YurianaWench.esp";
-        int amount = 1;
-        std::string event = "ostim_actor_orgasm";
-        bool male = true;
-        bool female = true;
-        bool showNotification = true;
-    } milkWench;
-
-    struct {
-        bool enabled = false;
-        std::string id = "65FEC3";
-        std::string pluginItem = "YurianaWench.esp";
-        std::string npc = "576A03";
-        std::string pluginNPC = "YurianaWench.esp";
-        int amount = 1;
-        std::string event = "ostim_actor_orgasm";
-        bool male = true;
-        bool female = true;
-        bool showNotification = true;
-    } milkEthel;
-};
-
 struct CapturedNPCData {
     RE::FormID formID = 0;
     std::string pluginName;
@@ -205,15 +53,6 @@ struct CapturedNPCData {
     std::chrono::steady_clock::time_point lastSeen;
 };
 
-struct CachedFormIDs {
-    RE::FormID item1 = 0;
-    RE::FormID item2 = 0;
-    RE::FormID milkDawnguard = 0;
-    RE::FormID milkWench = 0;
-    RE::FormID milkEthel = 0;
-    bool resolved = false;
-};
-
 struct ActorInfo {
     std::string name;
     RE::FormID refID = 0;
@@ -234,31 +73,38 @@ struct OStimEventData {
     std::chrono::steady_clock::time_point timestamp;
 };
 
-static std::deque<std::string> g_actionLines;
-static std::deque<std::string> g_animationLines;
-static std::deque<std::string> g_ostimEventLines;
+enum PluginLogFile : std::size_t {
+    kAnimationsLog,
+    kActionsLog,
+    kOStimEventsLog
+};
+
 static std::string g_documentsPath;
 static std::string g_gamePath;
 static bool g_isInitialized = false;
-static std::mutex g_logMutex;
-static std::mutex g_sceneMutex;
 static std::mutex g_configMutex;
 static std::mutex g_cacheMutex;
-static std::streampos g_lastOStimLogPosition = 0;
 static bool g_monitoringActive = false;
 static std::thread g_monitorThread;
-static int g_monitorCycles = 0;
-static std::unordered_set<std::string> g_processedLines;
-static size_t g_lastFileSize = 0;
-static std::string g_lastAnimation = "";
+static DeadlineScheduler g_monitorScheduler;
+static std::atomic<std::size_t> g_logTaskId(0);
 static std::chrono::steady_clock::time_point g_monitoringStartTime;
-static bool g_initialDelayComplete = false;
 static std::atomic<bool> g_isShuttingDown(false);
 static SKSELogsPaths g_ostimLogPaths;
-static PluginConfig g_config;
-static PluginConfigClimax g_configClimax;
+static ConfigSnapshot<PluginConfig> g_config;
+static ConfigSnapshot<PluginConfigClimax> g_configClimax;
+static ConfigSnapshot<PluginIndexTable> g_pluginIndices;
+static std::mutex g_pluginIndexMutex;
+static std::atomic<bool> g_pluginIndicesReady(false);
+
+enum CreatureFlag : std::uint8_t {
+    kCreatureVampire = 1 << 0,
+    kCreatureWerewolf = 1 << 1
+};
+
+static RE::TESFaction* g_vampireFaction = nullptr;
+static RE::TESFaction* g_werewolfFaction = nullptr;
 
-static bool g_inOStimScene = false;
 static std::chrono::steady_clock::time_point g_lastGoldRewardTime;
 static std::atomic<bool> g_goldRewardActive(false);
 
@@ -268,24 +114,15 @@ static float g_lastExhaustionValue = 0.0f;
 static std::chrono::steady_clock::time_point g_lastSurvivalReductionTime;
 static std::atomic<bool> g_survivalRestorationActive(false);
 static bool g_allStatsAtZero = false;
+static std::chrono::steady_clock::time_point g_lastFrostfallReductionTime;
+static std::atomic<bool> g_frostfallRestorationActive(false);
+static NeedsProvider<RE::TESGlobal> g_survivalNeeds{
+    "Survival Mode", {"Survival_HungerNeedValue", "Survival_ColdNeedValue", "Survival_ExhaustionNeedValue"}};
+static NeedsProvider<RE::TESGlobal> g_frostfallNeeds{"Frostfall", {"", "_Frost_AttributeExposure", ""}};
 
 static std::chrono::steady_clock::time_point g_lastAttributesRestorationTime;
 static std::atomic<bool> g_attributesRestorationActive(false);
 
-static std::chrono::steady_clock::time_point g_lastItem1RewardTime;
-static std::atomic<bool> g_item1RewardActive(false);
-
-static std::chrono::steady_clock::time_point g_lastItem2RewardTime;
-static std::atomic<bool> g_item2RewardActive(false);
-
-static std::chrono::steady_clock::time_point g_lastMilkRewardTime;
-static std::atomic<bool> g_milkRewardActive(false);
-
-static std::chrono::steady_clock::time_point g_lastMilkWenchRewardTime;
-static std::atomic<bool> g_milkWenchRewardActive(false);
-static std::chrono::steady_clock::time_point g_lastMilkEthelRewardTime;
-static std::atomic<bool> g_milkEthelRewardActive(false);
-
 static bool g_wenchMilkNPCDetected = false;
 static bool g_ethelNPCDetected = false;
 static std::chrono::steady_clock::time_point g_lastNPCDetectionCheck;
@@ -293,19 +130,57 @@ static std::chrono::steady_clock::time_point g_lastNPCDetectionCheck;
 static CapturedNPCData g_capturedYurianaWenchNPC;
 static CapturedNPCData g_capturedEthelNPC;
 
-static CachedFormIDs g_cachedItemFormIDs;
+static RewardTable<RE::TESBoundObject> g_rewardTable;
+static EffectQueue<RE::TESBoundObject, RE::TESGlobal, RE::ActorValue> g_effects;
+static const PluginConfig* g_rewardTableSource = nullptr;
 
-static HANDLE g_directoryHandle = INVALID_HANDLE_VALUE;
+static DirectoryWatcher g_logWatcher;
 static std::thread g_fileWatchThread;
 static std::atomic<bool> g_fileWatchActive(false);
 
-static std::vector<std::string> g_detectedNPCNames;
-static std::map<std::string, RE::FormID> g_npcNameToRefID;
-static std::map<std::string, ActorInfo> g_nearbyNPCsCache;
+// OStim.log flows through one thread per stage: the file watch thread owns the tailer and the
+// dedup set and turns new lines into events, the monitor thread owns the scene state and
+// applies them, and the main thread applies the game effects they produce. Each hand-off is a
+// single-producer queue, so none of that state is locked. The scene state is only touched from
+// other threads while the monitor thread is stopped.
+struct LogStageMessage {
+    enum class Type : std::uint8_t {
+        kEvent,
+        kLogReset,
+        kResume
+    };
+
+    // For kResume, event.node and event.speed carry the scene found at the end of the log.
+    Type type = Type::kEvent;
+    OStimEventRecord event;
+    bool threadClosing = false;
+};
+
+// An ostim_actor_orgasm mod event, handed from the main thread to the monitor thread.
+struct ClimaxMessage {
+    std::string actorName;
+    std::string gender;
+    bool isPlayer = false;
+};
+
+static OStimLogTailer g_ostimLogTailer;
+static OStimLineFilter g_lineFilter;
+static SpscQueue<LogStageMessage, 1024> g_logEvents;
+static SpscQueue<ClimaxMessage, 64> g_climaxEvents;
+static SceneStateMachine g_scene;
+// Bytes of OStim.log the file watch thread has not read yet, after its latest slice.
+static std::atomic<std::uint64_t> g_logBacklogBytes{0};
+
+static SceneActorTable g_sceneActorTable;
+static constexpr float kNearbyNPCRadius = 500.0f;
+static constexpr float kRefIDCaptureRadius = 1000.0f;
+static constexpr float kSceneActorRadius = 3000.0f;
+static ActorSnapshot g_actorSnapshot{kNearbyNPCRadius, kRefIDCaptureRadius, kSceneActorRadius};
+static std::mutex g_actorSnapshotMutex;
+static std::chrono::steady_clock::time_point g_actorSnapshotTime;
 static std::vector<ActorInfo> g_sceneActors;
 
 static std::map<int, OStimEventData> g_currentOStimEvents;
-static int g_currentOStimSpeed = 0;
 static std::chrono::steady_clock::time_point g_lastOStimEventCheck;
 
 void StartMonitoringThread();
@@ -315,39 +190,48 @@ void WriteToAnimationsLog(const std::string& message, int lineNumber = 0);
 void WriteToOStimEventsLog(const std::string& message, int lineNumber = 0);
 void CheckAndRewardGold();
 void CheckAndRestoreSurvivalStats();
+void CheckAndRestoreFrostfallExposure();
+void ResolveNeedsProviders();
 void CheckAndRestoreAttributes();
-void CheckAndRewardItem1();
-void CheckAndRewardItem2();
-void CheckAndRewardMilk();
-void CheckAndRewardMilkWench();
-void CheckAndRewardMilkEthel();
+void CheckAndRewardItems();
 void CheckForNearbyNPCs();
+bool IsActiveLogWatched();
+DeadlineScheduler::TimePoint SceneTaskDeadline(bool enabled, DeadlineScheduler::TimePoint due,
+                                               DeadlineScheduler::TimePoint now);
 void TryCaptureNPCFormIDs();
-void ResolveItemFormIDs();
+void RefreshRewardTable();
+void QueueGlobalReduction(RE::TESGlobal* global, float amount);
+void FlushEffects();
 void ValidateAndUpdatePluginsInINI();
 bool LoadConfiguration();
 void SaveDefaultConfiguration();
-std::string GetLastAnimation();
-void SetLastAnimation(const std::string& animation);
+const std::string& GetLastAnimation();
 bool IsInOStimScene();
-void SetInOStimScene(bool inScene);
+void ResetSceneState();
 fs::path GetPluginINIPath();
 RE::FormID GetFormIDFromPlugin(const std::string& pluginName, const std::string& localFormID);
 bool IsAnyNPCFromPluginNearPlayer(const std::string& pluginName, float maxDistance);
 bool IsSpecificNPCNearPlayer(RE::FormID npcFormID, float maxDistance);
-void DetectNPCNamesFromLine(const std::string& line);
+void DetectNPCNameFromVoiceSet(std::string_view npcName);
 void FindAndCacheNPCRefIDs();
+void RefreshActorSnapshot();
 void BuildNPCsCacheForScene();
 void ClearNPCsCache();
+void ClearDetectedNPCs();
 ActorInfo CapturePlayerInfo();
 ActorInfo CaptureNPCInfo(const std::string& npcName);
 void LogActorInfo(const ActorInfo& info, bool isPlayer);
 bool IsActorFromPlugin(RE::FormID actorFormID, const std::string& pluginName);
 bool IsDLCInstalled(const std::string& dlcName);
+PluginIndex GetPluginIndex(const std::string& pluginName);
+void BuildPluginIndexTable();
+void ResolveCreatureForms();
 bool IsActorVampire(RE::Actor* actor);
 bool IsActorWerewolf(RE::Actor* actor);
 std::string NormalizeName(const std::string& name);
-void ParseOStimEventFromLine(const std::string& line);
+void ProcessOrgasmLine(const OStimEvent& event);
+void ProcessSpeedChange();
+void ProcessNodeSpeedReset();
 void ProcessOStimEventData();
 void ProcessOrgasmEvent(const std::string& actorName, const std::string& gender, bool isPlayer);
 void ProcessClimaxGoldReward(const std::string& actorName, bool isPlayer);
@@ -409,190 +293,56 @@ std::string NormalizeName(const std::string& name) {
 }
 
 std::string GetCurrentTimeString() {
-    auto now = std::chrono::system_clock::now();
-    std::time_t time_t = std::chrono::system_clock::to_time_t(now);
-    std::tm buf;
-    localtime_s(&buf, &time_t);
-    std::stringstream ss;
-    ss << std::put_time(&buf, "%Y-%m-%d %H:%M:%S");
-    return ss.str();
+    char text[TimestampFormatter::kSecondsLength];
+    std::size_t length = TimestampFormatter::GetSingleton().FormatSeconds(std::chrono::system_clock::now(), text);
+    return std::string(text, length);
 }
 
 std::string GetCurrentTimeStringWithMillis() {
-    auto now = std::chrono::system_clock::now();
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
-    std::time_t time_t = std::chrono::system_clock::to_time_t(now);
-    std::tm buf;
-    localtime_s(&buf, &time_t);
-    std::stringstream ss;
-    ss << std::put_time(&buf, "%Y-%m-%d %H:%M:%S");
-    ss << "." << std::setfill('0') << std::setw(3) << ms.count();
-    return ss.str();
-}
-
-std::string GetLastAnimation() {
-    std::lock_guard<std::mutex> lock(g_sceneMutex);
-    return g_lastAnimation;
+    char text[TimestampFormatter::kMillisLength];
+    std::size_t length = TimestampFormatter::GetSingleton().FormatMillis(std::chrono::system_clock::now(), text);
+    return std::string(text, length);
 }
 
-void SetLastAnimation(const std::string& animation) {
-    std::lock_guard<std::mutex> lock(g_sceneMutex);
-    g_lastAnimation = animation;
+const std::string& GetLastAnimation() {
+    return g_scene.Animation();
 }
 
 bool IsInOStimScene() {
-    std::lock_guard<std::mutex> lock(g_sceneMutex);
-    return g_inOStimScene;
+    return g_scene.InScene();
 }
 
-void SetInOStimScene(bool inScene) {
-    std::lock_guard<std::mutex> lock(g_sceneMutex);
-    g_inOStimScene = inScene;
-    
-    if (!inScene) {
-        ClearNPCsCache();
-    }
+void ResetSceneState() {
+    g_scene.Reset();
+    ClearNPCsCache();
 }
 
 void WriteToAnimationsLog(const std::string& message, int lineNumber) {
-    std::lock_guard<std::mutex> lock(g_logMutex);
-
-    auto logsFolder = SKSE::log::log_directory();
-    if (!logsFolder) return;
-
-    auto logPath = *logsFolder / "OSurvival-Mode-NG-Animations.log";
-
-    auto now = std::chrono::system_clock::now();
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
-    std::time_t time_t = std::chrono::system_clock::to_time_t(now);
-    std::tm buf;
-    localtime_s(&buf, &time_t);
-
-    std::stringstream ss;
-    ss << "[" << std::put_time(&buf, "%Y-%m-%d %H:%M:%S");
-    ss << "." << std::setfill('0') << std::setw(3) << ms.count() << "] ";
-    ss << "[log] [info] ";
-    ss << "[plugin.cpp:" << lineNumber << "] ";
-    ss << message;
-
-    std::string newLine = ss.str();
-    g_animationLines.push_back(newLine);
-
-    if (g_animationLines.size() > 4000) {
-        for (int i = 0; i < 500; i++) {
-            if (!g_animationLines.empty()) {
-                g_animationLines.pop_front();
-            }
-        }
-        
-        std::ofstream animationsFile(logPath, std::ios::trunc);
-        if (animationsFile.is_open()) {
-            for (const auto& line : g_animationLines) {
-                animationsFile << line << std::endl;
-            }
-            animationsFile.close();
-        }
-    } else {
-        std::ofstream animationsFile(logPath, std::ios::app);
-        if (animationsFile.is_open()) {
-            animationsFile << newLine << std::endl;
-            animationsFile.close();
-        }
-    }
+    AsyncLogSink::GetSingleton().Write(kAnimationsLog, lineNumber, message);
 }
 
 void WriteToActionsLog(const std::string& message, int lineNumber) {
-    std::lock_guard<std::mutex> lock(g_logMutex);
-
-    auto logsFolder = SKSE::log::log_directory();
-    if (!logsFolder) return;
-
-    auto logPath = *logsFolder / "OSurvival-Mode-NG-Actions.log";
-
-    auto now = std::chrono::system_clock::now();
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
-    std::time_t time_t = std::chrono::system_clock::to_time_t(now);
-    std::tm buf;
-    localtime_s(&buf, &time_t);
-
-    std::stringstream ss;
-    ss << "[" << std::put_time(&buf, "%Y-%m-%d %H:%M:%S");
-    ss << "." << std::setfill('0') << std::setw(3) << ms.count() << "] ";
-    ss << "[log] [info] ";
-    ss << "[plugin.cpp:" << lineNumber << "] ";
-    ss << message;
-
-    std::string newLine = ss.str();
-    g_actionLines.push_back(newLine);
-
-    if (g_actionLines.size() > 4000) {
-        for (int i = 0; i < 500; i++) {
-            if (!g_actionLines.empty()) {
-                g_actionLines.pop_front();
-            }
-        }
-        
-        std::ofstream actionsFile(logPath, std::ios::trunc);
-        if (actionsFile.is_open()) {
-            for (const auto& line : g_actionLines) {
-                actionsFile << line << std::endl;
-            }
-            actionsFile.close();
-        }
-    } else {
-        std::ofstream actionsFile(logPath, std::ios::app);
-        if (actionsFile.is_open()) {
-            actionsFile << newLine << std::endl;
-            actionsFile.close();
-        }
-    }
+    AsyncLogSink::GetSingleton().Write(kActionsLog, lineNumber, message);
 }
 
 void WriteToOStimEventsLog(const std::string& message, int lineNumber) {
-    std::lock_guard<std::mutex> lock(g_logMutex);
+    AsyncLogSink::GetSingleton().Write(kOStimEventsLog, lineNumber, message);
+}
+
+void StartPluginLogs() {
+    auto& sink = AsyncLogSink::GetSingleton();
+    if (sink.IsRunning()) {
+        sink.Truncate();
+        return;
+    }
 
     auto logsFolder = SKSE::log::log_directory();
     if (!logsFolder) return;
 
-    auto logPath = *logsFolder / "OSurvival-Mode-NG-OStimEvents.log";
-
-    auto now = std::chrono::system_clock::now();
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
-    std::time_t time_t = std::chrono::system_clock::to_time_t(now);
-    std::tm buf;
-    localtime_s(&buf, &time_t);
-
-    std::stringstream ss;
-    ss << "[" << std::put_time(&buf, "%Y-%m-%d %H:%M:%S");
-    ss << "." << std::setfill('0') << std::setw(3) << ms.count() << "] ";
-    ss << "[ostim_events] [info] ";
-    ss << "[plugin.cpp:" << lineNumber << "] ";
-    ss << message;
-
-    std::string newLine = ss.str();
-    g_ostimEventLines.push_back(newLine);
-
-    if (g_ostimEventLines.size() > 4000) {
-        for (int i = 0; i < 500; i++) {
-            if (!g_ostimEventLines.empty()) {
-                g_ostimEventLines.pop_front();
-            }
-        }
-        
-        std::ofstream eventsFile(logPath, std::ios::trunc);
-        if (eventsFile.is_open()) {
-            for (const auto& line : g_ostimEventLines) {
-                eventsFile << line << std::endl;
-            }
-            eventsFile.close();
-        }
-    } else {
-        std::ofstream eventsFile(logPath, std::ios::app);
-        if (eventsFile.is_open()) {
-            eventsFile << newLine << std::endl;
-            eventsFile.close();
-        }
-    }
+    sink.SetFile(kAnimationsLog, *logsFolder / "OSurvival-Mode-NG-Animations.log", "[log] [info]");
+    sink.SetFile(kActionsLog, *logsFolder / "OSurvival-Mode-NG-Actions.log", "[log] [info]");
+    sink.SetFile(kOStimEventsLog, *logsFolder / "OSurvival-Mode-NG-OStimEvents.log", "[ostim_events] [info]");
+    sink.Start();
 }
 
 fs::path GetPluginINIPath() {
@@ -608,73 +358,124 @@ fs::path GetPluginINIPath() {
     return pluginConfigDir / "OSurvival-Mode-NG.ini";
 }
 
-bool IsDLCInstalled(const std::string& dlcName) {
-    auto* dataHandler = RE::TESDataHandler::GetSingleton();
-    if (!dataHandler) return false;
-    
-    auto* file = dataHandler->LookupModByName(dlcName);
-    return (file != nullptr);
+// A file that is installed but not active has compileIndex 0xFF. Taken as an index it would
+// match every runtime-created form (0xFF......), so it counts as not present.
+PluginIndex MakePluginIndex(const RE::TESFile* file) {
+    if (!file || file->compileIndex == 0xFF) {
+        return {};
+    }
+    if (file->compileIndex == 0xFE) {
+        return PluginIndex::Light(file->smallFileCompileIndex);
+    }
+    return PluginIndex::Regular(file->compileIndex);
 }
 
-bool IsActorVampire(RE::Actor* actor) {
-    if (!actor) return false;
-    
-    auto* actorBase = actor->GetActorBase();
-    if (!actorBase) return false;
-    
-    auto* actorClass = actorBase->npcClass;
-    if (actorClass) {
-        RE::FormID classID = actorClass->GetFormID();
-        if (classID == 0x0002E00F) {
-            return true;
+void BuildPluginIndexTable() {
+    auto* dataHandler = RE::TESDataHandler::GetSingleton();
+    if (!dataHandler) {
+        return;
+    }
+
+    const PluginConfig& config = g_config.Get();
+    const PluginConfigClimax& configClimax = g_configClimax.Get();
+
+    const std::string* names[] = {
+        &config.item1.plugin, &config.item2.plugin, &config.milk.plugin, &config.milkWench.plugin,
+        &config.milkEthel.pluginItem, &config.milkEthel.pluginNPC,
+        &configClimax.item1.plugin, &configClimax.item2.plugin, &configClimax.milk.plugin,
+        &configClimax.milkWench.plugin, &configClimax.milkEthel.pluginItem, &configClimax.milkEthel.pluginNPC
+    };
+
+    PluginIndexTable table;
+    table.Set("Skyrim.esm", MakePluginIndex(dataHandler->LookupModByName("Skyrim.esm")));
+    table.Set("Dawnguard.esm", MakePluginIndex(dataHandler->LookupModByName("Dawnguard.esm")));
+    for (const std::string* name : names) {
+        if (*name != "none" && !table.Find(*name)) {
+            table.Set(*name, MakePluginIndex(dataHandler->LookupModByName(*name)));
         }
     }
-    
+
+    std::lock_guard<std::mutex> lock(g_pluginIndexMutex);
+    g_pluginIndices.Publish(std::move(table));
+    g_pluginIndicesReady = true;
+
+    WriteToActionsLog("Plugin index table built: " + std::to_string(g_pluginIndices.Get().Size()) + " plugins", __LINE__);
+}
+
+// Plugins missing from the table (e.g. renamed in the INI after loading) are resolved once
+// and added to it.
+PluginIndex GetPluginIndex(const std::string& pluginName) {
+    if (const auto* index = g_pluginIndices.Get().Find(pluginName)) {
+        return *index;
+    }
+
     auto* dataHandler = RE::TESDataHandler::GetSingleton();
-    if (dataHandler && IsDLCInstalled("Dawnguard.esm")) {
-        auto* vampireFaction = dataHandler->LookupForm<RE::TESFaction>(0x020142E6, "Dawnguard.esm");
-        if (vampireFaction && actor->IsInFaction(vampireFaction)) {
-            return true;
-        }
+    if (!dataHandler) {
+        return {};
     }
-    
-    return false;
+
+    PluginIndex index = MakePluginIndex(dataHandler->LookupModByName(pluginName));
+    if (g_pluginIndicesReady) {
+        std::lock_guard<std::mutex> lock(g_pluginIndexMutex);
+        PluginIndexTable table = g_pluginIndices.Get();
+        table.Set(pluginName, index);
+        g_pluginIndices.Publish(std::move(table));
+    }
+    return index;
 }
 
-bool IsActorWerewolf(RE::Actor* actor) {
-    if (!actor) return false;
+bool IsDLCInstalled(const std::string& dlcName) {
+    return GetPluginIndex(dlcName).present;
+}
+
+void ResolveCreatureForms() {
+    PluginIndex dawnguard = GetPluginIndex("Dawnguard.esm");
+    PluginIndex skyrim = GetPluginIndex("Skyrim.esm");
+
+    g_vampireFaction = dawnguard.present ? RE::TESForm::LookupByID<RE::TESFaction>(dawnguard.Compose(0x0142E6)) : nullptr;
+    g_werewolfFaction = skyrim.present ? RE::TESForm::LookupByID<RE::TESFaction>(skyrim.Compose(0x09A741)) : nullptr;
+}
+
+// Faction membership belongs to the reference and can change at any time, so it is checked
+// on every call against the faction pointers ResolveCreatureForms() looked up once.
+std::uint8_t ClassifyCreature(RE::Actor* actor) {
+    if (!actor) return 0;
     
     auto* actorBase = actor->GetActorBase();
-    if (!actorBase) return false;
+    if (!actorBase) return 0;
     
     auto* actorClass = actorBase->npcClass;
-    if (actorClass) {
-        RE::FormID classID = actorClass->GetFormID();
-        if (classID == 0x000A1993 || classID == 0x000A1994 || classID == 0x000A1995) {
-            return true;
-        }
+    RE::FormID classID = actorClass ? actorClass->GetFormID() : 0;
+    
+    std::uint8_t flags = 0;
+    if (classID == 0x0002E00F) {
+        flags |= kCreatureVampire;
+    }
+    if (classID == 0x000A1993 || classID == 0x000A1994 || classID == 0x000A1995) {
+        flags |= kCreatureWerewolf;
     }
     
-    auto* dataHandler = RE::TESDataHandler::GetSingleton();
-    if (dataHandler) {
-        auto* werewolfFaction = dataHandler->LookupForm<RE::TESFaction>(0x0009A741, "Skyrim.esm");
-        if (werewolfFaction && actor->IsInFaction(werewolfFaction)) {
-            return true;
-        }
+    if (!(flags & kCreatureVampire) && g_vampireFaction && actor->IsInFaction(g_vampireFaction)) {
+        flags |= kCreatureVampire;
+    }
+    if (!(flags & kCreatureWerewolf) && g_werewolfFaction && actor->IsInFaction(g_werewolfFaction)) {
+        flags |= kCreatureWerewolf;
     }
     
-    return false;
+    return flags;
 }
 
-RE::FormID GetFormIDFromPlugin(const std::string& pluginName, const std::string& localFormID) {
-    auto* dataHandler = RE::TESDataHandler::GetSingleton();
-    if (!dataHandler) {
-        logger::error("Failed to get TESDataHandler");
-        return 0;
-    }
+bool IsActorVampire(RE::Actor* actor) {
+    return (ClassifyCreature(actor) & kCreatureVampire) != 0;
+}
+
+bool IsActorWerewolf(RE::Actor* actor) {
+    return (ClassifyCreature(actor) & kCreatureWerewolf) != 0;
+}
 
-    auto* file = dataHandler->LookupModByName(pluginName);
-    if (!file) {
+RE::FormID GetFormIDFromPlugin(const std::string& pluginName, const std::string& localFormID) {
+    PluginIndex plugin = GetPluginIndex(pluginName);
+    if (!plugin.present) {
         logger::error("Plugin not found: {}", pluginName);
         return 0;
     }
@@ -692,113 +493,30 @@ RE::FormID GetFormIDFromPlugin(const std::string& pluginName, const std::string&
         return 0;
     }
 
-    uint8_t modIndex = file->compileIndex;
-    if (modIndex == 0xFF) {
-        modIndex = file->smallFileCompileIndex;
-    }
-
-    RE::FormID fullFormID = (static_cast<RE::FormID>(modIndex) << 24) | (localID & 0x00FFFFFF);
-    
-    return fullFormID;
+    return plugin.Compose(localID);
 }
 
 bool IsAnyNPCFromPluginNearPlayer(const std::string& pluginName, float maxDistance) {
-    auto* player = RE::PlayerCharacter::GetSingleton();
-    if (!player) {
-        return false;
-    }
-    
-    auto* dataHandler = RE::TESDataHandler::GetSingleton();
-    if (!dataHandler) {
-        return false;
-    }
-    
-    auto* file = dataHandler->LookupModByName(pluginName);
-    if (!file) {
+    PluginIndex plugin = GetPluginIndex(pluginName);
+    if (!plugin.present) {
         return false;
     }
     
-    uint8_t modIndex = file->compileIndex;
-    if (modIndex == 0xFF) {
-        modIndex = file->smallFileCompileIndex;
-    }
-    
-    auto* processLists = RE::ProcessLists::GetSingleton();
-    if (!processLists) {
-        return false;
-    }
-    
-    RE::NiPoint3 playerPos = player->GetPosition();
-    
-    for (auto& actorHandle : processLists->highActorHandles) {
-        auto actor = actorHandle.get();
-        if (!actor) continue;
-        
-        auto* actorBase = actor->GetActorBase();
-        if (!actorBase) continue;
-        
-        uint8_t npcModIndex = (actorBase->formID >> 24) & 0xFF;
-        if (npcModIndex == modIndex) {
-            RE::NiPoint3 npcPos = actor->GetPosition();
-            float distance = playerPos.GetDistance(npcPos);
-            
-            if (distance <= maxDistance) {
-                return true;
-            }
-        }
-    }
+    RefreshActorSnapshot();
     
-    return false;
+    std::lock_guard<std::mutex> lock(g_actorSnapshotMutex);
+    return g_actorSnapshot.FindInPlugin(plugin, maxDistance) != ActorSnapshot::npos;
 }
 
 bool IsSpecificNPCNearPlayer(RE::FormID npcFormID, float maxDistance) {
-    auto* player = RE::PlayerCharacter::GetSingleton();
-    if (!player) {
-        return false;
-    }
-    
-    auto* processLists = RE::ProcessLists::GetSingleton();
-    if (!processLists) {
-        return false;
-    }
-    
-    RE::NiPoint3 playerPos = player->GetPosition();
-    
-    for (auto& actorHandle : processLists->highActorHandles) {
-        auto actor = actorHandle.get();
-        if (!actor) continue;
-        
-        auto* actorBase = actor->GetActorBase();
-        if (!actorBase) continue;
-        
-        if (actorBase->formID == npcFormID) {
-            RE::NiPoint3 npcPos = actor->GetPosition();
-            float distance = playerPos.GetDistance(npcPos);
-            
-            if (distance <= maxDistance) {
-                return true;
-            }
-        }
-    }
+    RefreshActorSnapshot();
     
-    return false;
+    std::lock_guard<std::mutex> lock(g_actorSnapshotMutex);
+    return g_actorSnapshot.FindByBaseID(npcFormID, maxDistance) != ActorSnapshot::npos;
 }
 
 bool IsActorFromPlugin(RE::FormID actorFormID, const std::string& pluginName) {
-    auto* dataHandler = RE::TESDataHandler::GetSingleton();
-    if (!dataHandler) return false;
-    
-    auto* file = dataHandler->LookupModByName(pluginName);
-    if (!file) return false;
-    
-    uint8_t modIndex = file->compileIndex;
-    if (modIndex == 0xFF) {
-        modIndex = file->smallFileCompileIndex;
-    }
-    
-    uint8_t actorModIndex = (actorFormID >> 24) & 0xFF;
-    
-    return (actorModIndex == modIndex);
+    return GetPluginIndex(pluginName).Contains(actorFormID);
 }
 
 std::string GetDocumentsPath() {
@@ -1093,19 +811,28 @@ SKSELogsPaths GetAllSKSELogsPaths() {
     return paths;
 }
 
-void BuildNPCsCacheForScene() {
-    std::lock_guard<std::mutex> lock(g_cacheMutex);
+void RefreshActorSnapshot() {
+    auto now = std::chrono::steady_clock::now();
     
-    g_nearbyNPCsCache.clear();
+    std::lock_guard<std::mutex> lock(g_actorSnapshotMutex);
     
-    auto* player = RE::PlayerCharacter::GetSingleton();
-    if (!player) return;
+    if (g_actorSnapshot.Revision() != 0 && now - g_actorSnapshotTime < std::chrono::milliseconds(250)) {
+        return;
+    }
+    
+    g_actorSnapshotTime = now;
     
+    auto* player = RE::PlayerCharacter::GetSingleton();
     auto* processLists = RE::ProcessLists::GetSingleton();
-    if (!processLists) return;
+    if (!player || !processLists) {
+        g_actorSnapshot.Clear();
+        return;
+    }
     
     RE::NiPoint3 playerPos = player->GetPosition();
-    float maxDistance = 3000.0f;
+    g_actorSnapshot.Begin(playerPos.x, playerPos.y, playerPos.z);
+    g_actorSnapshot.Reserve(processLists->highActorHandles.size() + processLists->middleHighActorHandles.size() +
+                            processLists->lowActorHandles.size());
     
     auto processActorList = [&](auto& actorHandles) {
         for (auto& actorHandle : actorHandles) {
@@ -1115,49 +842,78 @@ void BuildNPCsCacheForScene() {
             auto* actorBase = actor->GetActorBase();
             if (!actorBase) continue;
             
+            const char* name = actorBase->GetName();
             RE::NiPoint3 npcPos = actor->GetPosition();
-            float distance = playerPos.GetDistance(npcPos);
-            
-            if (distance <= maxDistance) {
-                ActorInfo info;
-                info.name = actorBase->GetName();
-                info.refID = actor->GetFormID();
-                info.baseID = actorBase->GetFormID();
-                
-                auto* race = actorBase->GetRace();
-                if (race) {
-                    info.race = race->GetName();
-                } else {
-                    info.race = "Unknown";
-                }
-                
-                info.gender = actorBase->IsFemale() ? "Female" : "Male";
-                
-                info.isVampire = IsActorVampire(actor.get());
-                info.isWerewolf = IsActorWerewolf(actor.get());
-                
-                info.captured = true;
-                
-                std::string normalizedName = NormalizeName(info.name);
-                
-                g_nearbyNPCsCache[normalizedName] = info;
-            }
+            g_actorSnapshot.Add(actor->GetFormID(), actorBase->GetFormID(), npcPos.x, npcPos.y, npcPos.z,
+                                ActorSnapshot::NameKey(name ? name : ""));
         }
     };
     
     processActorList(processLists->highActorHandles);
     processActorList(processLists->middleHighActorHandles);
     processActorList(processLists->lowActorHandles);
+    g_actorSnapshot.End();
+}
+
+void BuildNPCsCacheForScene() {
+    RefreshActorSnapshot();
+    
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    std::lock_guard<std::mutex> snapshotLock(g_actorSnapshotMutex);
+    
+    g_sceneActorTable.ClearActors();
+    
+    g_actorSnapshot.ForEachWithin(kSceneActorRadius, [](std::size_t i) {
+        auto* actor = RE::TESForm::LookupByID<RE::Actor>(g_actorSnapshot.RefID(i));
+        if (!actor) return;
+        
+        auto* actorBase = actor->GetActorBase();
+        if (!actorBase) return;
+        
+        SceneActorTable::Actor entry;
+        entry.refID = g_actorSnapshot.RefID(i);
+        entry.baseID = g_actorSnapshot.BaseID(i);
+        entry.x = g_actorSnapshot.X(i);
+        entry.y = g_actorSnapshot.Y(i);
+        entry.z = g_actorSnapshot.Z(i);
+        entry.isFemale = actorBase->IsFemale();
+        entry.isVampire = IsActorVampire(actor);
+        entry.isWerewolf = IsActorWerewolf(actor);
+        
+        auto* race = actorBase->GetRace();
+        std::string raceName = race ? race->GetName() : "Unknown";
+        
+        g_sceneActorTable.Add(NormalizeName(actorBase->GetName()), raceName, entry);
+    });
     
-    WriteToAnimationsLog("NPC cache built: " + std::to_string(g_nearbyNPCsCache.size()) + " NPCs within 3000 units", __LINE__);
+    WriteToAnimationsLog("NPC cache built: " + std::to_string(g_sceneActorTable.Size()) + " NPCs within " +
+        std::to_string(static_cast<int>(kSceneActorRadius)) + " units", __LINE__);
+}
+
+ActorInfo MakeActorInfo(const SceneActorTable::Actor& actor) {
+    ActorInfo info;
+    info.name = g_sceneActorTable.Name(actor.name);
+    info.refID = actor.refID;
+    info.baseID = actor.baseID;
+    info.race = g_sceneActorTable.Name(actor.race);
+    info.gender = actor.isFemale ? "Female" : "Male";
+    info.isVampire = actor.isVampire;
+    info.isWerewolf = actor.isWerewolf;
+    info.captured = true;
+    return info;
 }
 
 void ClearNPCsCache() {
     std::lock_guard<std::mutex> lock(g_cacheMutex);
-    g_nearbyNPCsCache.clear();
+    g_sceneActorTable.ClearActors();
     WriteToAnimationsLog("NPC cache cleared", __LINE__);
 }
 
+void ClearDetectedNPCs() {
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    g_sceneActorTable.Clear();
+}
+
 ActorInfo CapturePlayerInfo() {
     ActorInfo info;
     
@@ -1196,79 +952,30 @@ ActorInfo CaptureNPCInfo(const std::string& npcName) {
     ActorInfo info;
     info.name = npcName;
     
-    auto* player = RE::PlayerCharacter::GetSingleton();
-    if (!player) {
-        return info;
+    RefreshActorSnapshot();
+    
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    std::lock_guard<std::mutex> snapshotLock(g_actorSnapshotMutex);
+    const auto* actor = g_sceneActorTable.FindByName(NormalizeName(npcName));
+    if (actor && g_actorSnapshot.FindByRefID(actor->refID, kSceneActorRadius) != ActorSnapshot::npos) {
+        info = MakeActorInfo(*actor);
+        info.name = npcName;
     }
     
-    auto* processLists = RE::ProcessLists::GetSingleton();
-    if (!processLists) {
-        return info;
+    return info;
+}
+
+void LogActorInfo(const ActorInfo& info, bool isPlayer) {
+    if (!info.captured) {
+        WriteToAnimationsLog("Failed to capture info for: " + info.name, __LINE__);
+        return;
     }
     
-    RE::NiPoint3 playerPos = player->GetPosition();
-    float maxDistance = 3000.0f;
+    std::string actorType = isPlayer ? "PLAYER" : "NPC";
     
-    std::string normalizedSearchName = NormalizeName(npcName);
-    
-    auto searchInList = [&](auto& actorHandles) -> bool {
-        for (auto& actorHandle : actorHandles) {
-            auto actor = actorHandle.get();
-            if (!actor) continue;
-            
-            auto* actorBase = actor->GetActorBase();
-            if (!actorBase) continue;
-            
-            std::string actorName = actorBase->GetName();
-            std::string normalizedActorName = NormalizeName(actorName);
-            
-            if (normalizedActorName == normalizedSearchName) {
-                RE::NiPoint3 npcPos = actor->GetPosition();
-                float distance = playerPos.GetDistance(npcPos);
-                
-                if (distance <= maxDistance) {
-                    info.refID = actor->GetFormID();
-                    info.baseID = actorBase->GetFormID();
-                    
-                    auto* race = actorBase->GetRace();
-                    if (race) {
-                        info.race = race->GetName();
-                    } else {
-                        info.race = "Unknown";
-                    }
-                    
-                    info.gender = actorBase->IsFemale() ? "Female" : "Male";
-                    
-                    info.isVampire = IsActorVampire(actor.get());
-                    info.isWerewolf = IsActorWerewolf(actor.get());
-                    
-                    info.captured = true;
-                    
-                    return true;
-                }
-            }
-        }
-        return false;
-    };
-    
-    if (searchInList(processLists->highActorHandles)) return info;
-    if (searchInList(processLists->middleHighActorHandles)) return info;
-    if (searchInList(processLists->lowActorHandles)) return info;
-    
-    return info;
-}
-
-void LogActorInfo(const ActorInfo& info, bool isPlayer) {
-    if (!info.captured) {
-        WriteToAnimationsLog("Failed to capture info for: " + info.name, __LINE__);
-        return;
-    }
-    
-    std::string actorType = isPlayer ? "PLAYER" : "NPC";
-    
-    WriteToAnimationsLog("========================================", __LINE__);
-    WriteToAnimationsLog(actorType + " DETECTED IN OSTIM SCENE", __LINE__);
-    WriteToAnimationsLog("Name: " + info.name, __LINE__);
+    WriteToAnimationsLog("========================================", __LINE__);
+    WriteToAnimationsLog(actorType + " DETECTED IN OSTIM SCENE", __LINE__);
+    WriteToAnimationsLog("Name: " + info.name, __LINE__);
     
     std::stringstream refIDStr;
     refIDStr << "Reference ID: 0x" << std::hex << std::uppercase << info.refID;
@@ -1285,234 +992,115 @@ void LogActorInfo(const ActorInfo& info, bool isPlayer) {
     WriteToAnimationsLog("========================================", __LINE__);
 }
 
-void DetectNPCNamesFromLine(const std::string& line) {
-    bool hasVoiceSetFound = (line.find("voice set") != std::string::npos && 
-                             line.find("found for actor") != std::string::npos);
-    bool hasNoVoiceSet = (line.find("no voice set found for actor") != std::string::npos);
-    
-    if (!hasVoiceSetFound && !hasNoVoiceSet) {
-        return;
+void DetectNPCNameFromVoiceSet(std::string_view npcName) {
+    bool cacheEmpty = false;
+    {
+        std::lock_guard<std::mutex> lock(g_cacheMutex);
+        cacheEmpty = g_sceneActorTable.Empty();
     }
     
-    if (g_nearbyNPCsCache.empty()) {
+    if (cacheEmpty) {
         WriteToAnimationsLog("Cache empty when detecting NPC - building now", __LINE__);
         BuildNPCsCacheForScene();
     }
-
-    size_t actorPos = line.find("found for actor ");
-    if (actorPos == std::string::npos) {
-        return;
-    }
-
-    size_t nameStart = actorPos + 16;
-    
-    size_t nameEndBy = line.find(" by", nameStart);
-    size_t nameEndComma = line.find(", using", nameStart);
-    
-    size_t nameEnd = std::string::npos;
-    if (nameEndBy != std::string::npos && nameEndComma != std::string::npos) {
-        nameEnd = std::min(nameEndBy, nameEndComma);
-    } else if (nameEndBy != std::string::npos) {
-        nameEnd = nameEndBy;
-    } else if (nameEndComma != std::string::npos) {
-        nameEnd = nameEndComma;
-    }
     
-    if (nameEnd == std::string::npos || nameEnd <= nameStart) {
-        return;
+    auto* player = RE::PlayerCharacter::GetSingleton();
+    if (player) {
+        auto* playerBase = player->GetActorBase();
+        if (playerBase) {
+            std::string_view playerName = TrimOStimField(playerBase->GetName());
+            
+            if (playerName == npcName) {
+                WriteToAnimationsLog("Detected player name in OStim log, skipping: " + std::string(npcName), __LINE__);
+                return;
+            }
+        }
     }
-
-    std::string npcName = line.substr(nameStart, nameEnd - nameStart);
-    
-    npcName.erase(0, npcName.find_first_not_of(" \t\r\n"));
-    npcName.erase(npcName.find_last_not_of(" \t\r\n") + 1);
     
-    if (npcName.empty() || npcName == ",") {
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    if (!g_sceneActorTable.MarkDetected(npcName)) {
         return;
     }
     
-    bool alreadyDetected = false;
-    for (const auto& detectedName : g_detectedNPCNames) {
-        if (detectedName == npcName) {
-            alreadyDetected = true;
-            break;
-        }
-    }
+    const auto* actor = g_sceneActorTable.FindByName(npcName);
     
-    if (!alreadyDetected) {
-        auto* player = RE::PlayerCharacter::GetSingleton();
-        if (player) {
-            auto* playerBase = player->GetActorBase();
-            if (playerBase) {
-                std::string playerName = playerBase->GetName();
-                std::string normalizedPlayerName = NormalizeName(playerName);
-                std::string normalizedNPCName = NormalizeName(npcName);
-                
-                if (normalizedPlayerName == normalizedNPCName) {
-                    WriteToAnimationsLog("Detected player name in OStim log, skipping: " + npcName, __LINE__);
-                    return;
-                }
-            }
-        }
-        
-        g_detectedNPCNames.push_back(npcName);
-        
-        std::string normalizedNPCName = NormalizeName(npcName);
-        
-        std::lock_guard<std::mutex> lock(g_cacheMutex);
-        auto it = g_nearbyNPCsCache.find(normalizedNPCName);
-        
-        if (it != g_nearbyNPCsCache.end()) {
-            ActorInfo npcInfo = it->second;
-            g_sceneActors.push_back(npcInfo);
-            LogActorInfo(npcInfo, false);
-        } else {
-            WriteToAnimationsLog("========================================", __LINE__);
-            WriteToAnimationsLog("NPC NOT FOUND IN CACHE", __LINE__);
-            WriteToAnimationsLog("Name from OStim log: " + npcName, __LINE__);
-            WriteToAnimationsLog("Normalized name: " + normalizedNPCName, __LINE__);
-            WriteToAnimationsLog("Cache size: " + std::to_string(g_nearbyNPCsCache.size()) + " NPCs", __LINE__);
-            WriteToAnimationsLog("========================================", __LINE__);
-        }
+    if (actor) {
+        ActorInfo npcInfo = MakeActorInfo(*actor);
+        g_sceneActors.push_back(npcInfo);
+        LogActorInfo(npcInfo, false);
+    } else {
+        WriteToAnimationsLog("========================================", __LINE__);
+        WriteToAnimationsLog("NPC NOT FOUND IN CACHE", __LINE__);
+        WriteToAnimationsLog("Name from OStim log: " + std::string(npcName), __LINE__);
+        WriteToAnimationsLog("Normalized name: " + std::string(npcName), __LINE__);
+        WriteToAnimationsLog("Cache size: " + std::to_string(g_sceneActorTable.Size()) + " NPCs", __LINE__);
+        WriteToAnimationsLog("========================================", __LINE__);
     }
 }
 
 void FindAndCacheNPCRefIDs() {
-    if (g_detectedNPCNames.empty()) {
-        return;
-    }
+    const PluginConfig& config = g_config.Get();
 
-    auto* player = RE::PlayerCharacter::GetSingleton();
-    if (!player) {
-        return;
-    }
+    RefreshActorSnapshot();
 
-    auto* processLists = RE::ProcessLists::GetSingleton();
-    if (!processLists) {
-        return;
-    }
-
-    RE::NiPoint3 playerPos = player->GetPosition();
-
-    for (const auto& npcName : g_detectedNPCNames) {
-        if (g_npcNameToRefID.find(npcName) != g_npcNameToRefID.end()) {
-            continue;
-        }
+    std::vector<std::string> notFoundNames;
 
-        bool found = false;
-        std::string normalizedSearchName = NormalizeName(npcName);
-
-        auto searchInList = [&](auto& actorHandles) -> bool {
-            for (auto& actorHandle : actorHandles) {
-                auto actor = actorHandle.get();
-                if (!actor) continue;
-
-                auto* actorBase = actor->GetActorBase();
-                if (!actorBase) continue;
-
-                std::string actorName = actorBase->GetName();
-                std::string normalizedActorName = NormalizeName(actorName);
-                
-                if (normalizedActorName == normalizedSearchName) {
-                    RE::NiPoint3 npcPos = actor->GetPosition();
-                    float distance = playerPos.GetDistance(npcPos);
+    {
+        std::lock_guard<std::mutex> lock(g_cacheMutex);
+        std::lock_guard<std::mutex> snapshotLock(g_actorSnapshotMutex);
 
-                    if (distance <= 1000.0f) {
-                        g_npcNameToRefID[npcName] = actor->GetFormID();
-                        
-                        WriteToActionsLog("NPC RefID cached: " + npcName + " = 0x" + 
-                            std::to_string(actor->GetFormID()), __LINE__);
-                        return true;
-                    }
-                }
+        for (std::uint32_t nameID : g_sceneActorTable.Detected()) {
+            if (g_sceneActorTable.ResolvedRefID(nameID) != 0) {
+                continue;
             }
-            return false;
-        };
 
-        if (searchInList(processLists->highActorHandles)) {
-            found = true;
-        } else if (searchInList(processLists->middleHighActorHandles)) {
-            found = true;
-        } else if (searchInList(processLists->lowActorHandles)) {
-            found = true;
-        }
+            const auto* actor = g_sceneActorTable.ActorForName(nameID);
+            if (actor && g_actorSnapshot.FindByRefID(actor->refID, kRefIDCaptureRadius) != ActorSnapshot::npos) {
+                g_sceneActorTable.SetResolvedRefID(nameID, actor->refID);
 
-        if (!found) {
-            if (g_config.notification.enabled) {
-                std::string msg = "OSurvival - " + npcName + " apparently it's like a ghost";
-                RE::DebugNotification(msg.c_str());
+                WriteToActionsLog("NPC RefID cached: " + std::string(g_sceneActorTable.Name(nameID)) + " = 0x" +
+                    std::to_string(actor->refID), __LINE__);
+            } else {
+                notFoundNames.emplace_back(g_sceneActorTable.Name(nameID));
             }
         }
     }
-}
 
-void ParseOStimEventFromLine(const std::string& line) {
-    if (line.find("ostim_actor_orgasm") != std::string::npos) {
-        size_t actorPos = line.find("actor:");
-        if (actorPos != std::string::npos) {
-            size_t nameStart = actorPos + 6;
-            size_t nameEnd = line.find(",", nameStart);
-            if (nameEnd == std::string::npos) nameEnd = line.find(" ", nameStart);
-            if (nameEnd == std::string::npos) nameEnd = line.length();
-            
-            std::string actorName = line.substr(nameStart, nameEnd - nameStart);
-            actorName.erase(0, actorName.find_first_not_of(" \t\r\n"));
-            actorName.erase(actorName.find_last_not_of(" \t\r\n") + 1);
-            
-            std::string genderStr = "Unknown";
-            size_t genderPos = line.find("gender:");
-            if (genderPos != std::string::npos) {
-                size_t genderStart = genderPos + 7;
-                size_t genderEnd = line.find(",", genderStart);
-                if (genderEnd == std::string::npos) genderEnd = line.find(" ", genderStart);
-                if (genderEnd == std::string::npos) genderEnd = line.length();
-                genderStr = line.substr(genderStart, genderEnd - genderStart);
-                genderStr.erase(0, genderStr.find_first_not_of(" \t\r\n"));
-                genderStr.erase(genderStr.find_last_not_of(" \t\r\n") + 1);
-            }
-            
-            bool isPlayer = (actorName.find("Player") != std::string::npos || 
-                           actorName.find("player") != std::string::npos);
-            
-            ProcessOrgasmEvent(actorName, genderStr, isPlayer);
+    if (config.notification.enabled) {
+        for (const auto& npcName : notFoundNames) {
+            std::string msg = "OSurvival - " + npcName + " apparently it's like a ghost";
+            g_effects.Notify(msg);
         }
     }
+}
+
+void ProcessOrgasmLine(const OStimEvent& event) {
+    bool isPlayer = (event.actor.find("Player") != std::string_view::npos || 
+                     event.actor.find("player") != std::string_view::npos);
     
-    if (line.find("[Thread.cpp") != std::string::npos && line.find("changed speed to") != std::string::npos) {
-        size_t speedPos = line.find("changed speed to ");
-        if (speedPos != std::string::npos) {
-            try {
-                std::string speedStr = line.substr(speedPos + 17);
-                speedStr = speedStr.substr(0, speedStr.find_first_not_of("0123456789"));
-                int newSpeed = std::stoi(speedStr);
-                
-                if (newSpeed != g_currentOStimSpeed) {
-                    g_currentOStimSpeed = newSpeed;
-                    
-                    std::vector<std::string> speedNames = {"Slow", "Medium", "Fast", "Rough"};
-                    std::string speedName = (newSpeed >= 0 && newSpeed < static_cast<int>(speedNames.size())) 
-                        ? speedNames[newSpeed] : "Unknown";
-                    
-                    WriteToOStimEventsLog("========================================", __LINE__);
-                    WriteToOStimEventsLog("SPEED CHANGE EVENT", __LINE__);
-                    WriteToOStimEventsLog("New speed: " + speedName + " (Level " + std::to_string(newSpeed) + ")", __LINE__);
-                    WriteToOStimEventsLog("Current animation: " + GetLastAnimation(), __LINE__);
-                    WriteToOStimEventsLog("========================================", __LINE__);
-                }
-            } catch (...) {
-            }
-        }
-    }
+    ProcessOrgasmEvent(std::string(event.actor), std::string(event.gender), isPlayer);
+}
+
+void ProcessSpeedChange() {
+    int newSpeed = g_scene.Speed();
+
+    static constexpr std::array<std::string_view, 4> speedNames = {"Slow", "Medium", "Fast", "Rough"};
+    std::string_view speedName = (newSpeed >= 0 && newSpeed < static_cast<int>(speedNames.size())) 
+        ? speedNames[newSpeed] : "Unknown";
     
-    if (line.find("[Thread.cpp:195] thread 0 changed to node") != std::string::npos) {
-        g_currentOStimSpeed = 0;
-        
-        WriteToOStimEventsLog("========================================", __LINE__);
-        WriteToOStimEventsLog("ANIMATION CHANGE EVENT", __LINE__);
-        WriteToOStimEventsLog("Animation changed - speed reset", __LINE__);
-        WriteToOStimEventsLog("New animation: " + GetLastAnimation(), __LINE__);
-        WriteToOStimEventsLog("========================================", __LINE__);
-    }
+    WriteToOStimEventsLog("========================================", __LINE__);
+    WriteToOStimEventsLog("SPEED CHANGE EVENT", __LINE__);
+    WriteToOStimEventsLog("New speed: " + std::string(speedName) + " (Level " + std::to_string(newSpeed) + ")", __LINE__);
+    WriteToOStimEventsLog("Current animation: " + GetLastAnimation(), __LINE__);
+    WriteToOStimEventsLog("========================================", __LINE__);
+}
+
+void ProcessNodeSpeedReset() {
+    WriteToOStimEventsLog("========================================", __LINE__);
+    WriteToOStimEventsLog("ANIMATION CHANGE EVENT", __LINE__);
+    WriteToOStimEventsLog("Animation changed - speed reset", __LINE__);
+    WriteToOStimEventsLog("New animation: " + GetLastAnimation(), __LINE__);
+    WriteToOStimEventsLog("========================================", __LINE__);
 }
 
 void ProcessOStimEventData() {
@@ -1529,18 +1117,26 @@ void ProcessOStimEventData() {
     
     g_lastOStimEventCheck = now;
     
-    if (g_currentOStimSpeed > 0) {
+    if (g_scene.Speed() > 0) {
         WriteToOStimEventsLog("========================================", __LINE__);
         WriteToOStimEventsLog("PERIODIC STATUS UPDATE", __LINE__);
         WriteToOStimEventsLog("Current animation: " + GetLastAnimation(), __LINE__);
-        WriteToOStimEventsLog("Current speed level: " + std::to_string(g_currentOStimSpeed), __LINE__);
+        WriteToOStimEventsLog("Current speed level: " + std::to_string(g_scene.Speed()), __LINE__);
         WriteToOStimEventsLog("========================================", __LINE__);
     }
+
+    std::uint64_t backlogBytes = g_logBacklogBytes.load(std::memory_order_relaxed);
+    std::size_t queuedEvents = g_logEvents.Size();
+    if (backlogBytes > 0 || queuedEvents > 0) {
+        WriteToOStimEventsLog(std::format("OStim.log backlog: {} KB unread, {} events queued", backlogBytes / 1024,
+                                          queuedEvents),
+                              __LINE__);
+    }
 }
 
 void ProcessOrgasmEvent(const std::string& actorName, const std::string& gender, bool isPlayer) {
-    LoadClimaxConfiguration();
-    
+    const PluginConfigClimax& configClimax = g_configClimax.Get();
+
     WriteToOStimEventsLog("========================================", __LINE__);
     WriteToOStimEventsLog("ORGASM EVENT DETECTED", __LINE__);
     WriteToOStimEventsLog("Actor: " + actorName, __LINE__);
@@ -1551,318 +1147,234 @@ void ProcessOrgasmEvent(const std::string& actorName, const std::string& gender,
     bool isMale = (gender == "Male" || gender == "male");
     bool isFemale = (gender == "Female" || gender == "female");
     
-    if (g_configClimax.gold.enabled && 
-        ((isMale && g_configClimax.gold.male) || (isFemale && g_configClimax.gold.female))) {
+    if (configClimax.gold.enabled && 
+        ((isMale && configClimax.gold.male) || (isFemale && configClimax.gold.female))) {
         ProcessClimaxGoldReward(actorName, isPlayer);
     }
     
-    if (g_configClimax.survival.enabled && 
-        ((isMale && g_configClimax.survival.male) || (isFemale && g_configClimax.survival.female))) {
+    if (configClimax.survival.enabled && 
+        ((isMale && configClimax.survival.male) || (isFemale && configClimax.survival.female))) {
         ProcessClimaxSurvivalRestore(actorName, isPlayer);
     }
     
-    if (g_configClimax.attributes.enabled && 
-        ((isMale && g_configClimax.attributes.male) || (isFemale && g_configClimax.attributes.female))) {
+    if (configClimax.attributes.enabled && 
+        ((isMale && configClimax.attributes.male) || (isFemale && configClimax.attributes.female))) {
         ProcessClimaxAttributesRestore(actorName, isPlayer);
     }
     
-    if (g_configClimax.item1.enabled && g_configClimax.item1.plugin != "none" &&
-        ((isMale && g_configClimax.item1.male) || (isFemale && g_configClimax.item1.female))) {
+    if (configClimax.item1.enabled && configClimax.item1.plugin != "none" &&
+        ((isMale && configClimax.item1.male) || (isFemale && configClimax.item1.female))) {
         ProcessClimaxItem1Reward(actorName, isPlayer);
     }
     
-    if (g_configClimax.item2.enabled && g_configClimax.item2.plugin != "none" &&
-        ((isMale && g_configClimax.item2.male) || (isFemale && g_configClimax.item2.female))) {
+    if (configClimax.item2.enabled && configClimax.item2.plugin != "none" &&
+        ((isMale && configClimax.item2.male) || (isFemale && configClimax.item2.female))) {
         ProcessClimaxItem2Reward(actorName, isPlayer);
     }
     
-    if (g_configClimax.milk.enabled && 
-        ((isMale && g_configClimax.milk.male) || (isFemale && g_configClimax.milk.female))) {
+    if (configClimax.milk.enabled && 
+        ((isMale && configClimax.milk.male) || (isFemale && configClimax.milk.female))) {
         ProcessClimaxMilkReward(actorName, isPlayer);
     }
     
-    if (g_configClimax.milkWench.enabled && g_wenchMilkNPCDetected &&
-        ((isMale && g_configClimax.milkWench.male) || (isFemale && g_configClimax.milkWench.female))) {
+    if (configClimax.milkWench.enabled && g_wenchMilkNPCDetected &&
+        ((isMale && configClimax.milkWench.male) || (isFemale && configClimax.milkWench.female))) {
         ProcessClimaxMilkWenchReward(actorName, isPlayer);
     }
     
-    if (g_configClimax.milkEthel.enabled && g_ethelNPCDetected &&
-        ((isMale && g_configClimax.milkEthel.male) || (isFemale && g_configClimax.milkEthel.female))) {
+    if (configClimax.milkEthel.enabled && g_ethelNPCDetected &&
+        ((isMale && configClimax.milkEthel.male) || (isFemale && configClimax.milkEthel.female))) {
         ProcessClimaxMilkEthelReward(actorName, isPlayer);
     }
 }
 
 void ProcessClimaxGoldReward(const std::string& actorName, bool isPlayer) {
-    
-    auto* player = RE::PlayerCharacter::GetSingleton();
+    const PluginConfigClimax& configClimax = g_configClimax.Get();
+
     auto* gold = RE::TESForm::LookupByID<RE::TESBoundObject>(0x0000000F);
     
-    if (player && gold) {
-        player->AddObjectToContainer(gold, nullptr, g_configClimax.gold.amount, nullptr);
+    if (gold) {
+        g_effects.AddItem(gold, configClimax.gold.amount);
         
-        if (g_configClimax.gold.showNotification) {
-            std::string msg = "OSurvival Climax - Received " + std::to_string(g_configClimax.gold.amount) + " gold";
-            RE::DebugNotification(msg.c_str());
+        if (configClimax.gold.showNotification) {
+            std::string msg = "OSurvival Climax - Received " + std::to_string(configClimax.gold.amount) + " gold";
+            g_effects.Notify(msg);
         }
         
-        WriteToActionsLog("Climax Gold reward: " + std::to_string(g_configClimax.gold.amount) + " gold", __LINE__);
+        WriteToActionsLog("Climax Gold reward: " + std::to_string(configClimax.gold.amount) + " gold", __LINE__);
     }
 }
 
 void ProcessClimaxSurvivalRestore(const std::string& actorName, bool isPlayer) {
-    
-    auto hungerGlobal = RE::TESForm::LookupByEditorID<RE::TESGlobal>("Survival_HungerNeedValue");
-    auto coldGlobal = RE::TESForm::LookupByEditorID<RE::TESGlobal>("Survival_ColdNeedValue");
-    auto exhaustionGlobal = RE::TESForm::LookupByEditorID<RE::TESGlobal>("Survival_ExhaustionNeedValue");
-    
-    if (!hungerGlobal || !coldGlobal || !exhaustionGlobal) {
+    const PluginConfigClimax& configClimax = g_configClimax.Get();
+
+    if (!g_survivalNeeds.IsResolved()) {
         return;
     }
     
-    float currentHunger = hungerGlobal->value;
-    float currentCold = coldGlobal->value;
-    float currentExhaustion = exhaustionGlobal->value;
-    
-    float newHunger = std::max(0.0f, currentHunger - static_cast<float>(g_configClimax.survival.reductionAmountHunger));
-    float newCold = std::max(0.0f, currentCold - static_cast<float>(g_configClimax.survival.reductionAmountCold));
-    float newExhaustion = std::max(0.0f, currentExhaustion - static_cast<float>(g_configClimax.survival.reductionAmountExhaustion));
+    g_survivalNeeds.Reduce(g_survivalNeeds.Read(),
+                           {static_cast<float>(configClimax.survival.reductionAmountHunger),
+                            static_cast<float>(configClimax.survival.reductionAmountCold),
+                            static_cast<float>(configClimax.survival.reductionAmountExhaustion)},
+                           QueueGlobalReduction);
     
-    hungerGlobal->value = newHunger;
-    coldGlobal->value = newCold;
-    exhaustionGlobal->value = newExhaustion;
-    
-    if (g_configClimax.survival.showNotification) {
-        RE::DebugNotification("OSurvival Climax - Survival needs reduced");
+    if (configClimax.survival.showNotification) {
+        g_effects.Notify("OSurvival Climax - Survival needs reduced");
     }
     
     WriteToActionsLog("Climax Survival restore applied", __LINE__);
 }
 
 void ProcessClimaxAttributesRestore(const std::string& actorName, bool isPlayer) {
+    const PluginConfigClimax& configClimax = g_configClimax.Get();
+
+    float amount = static_cast<float>(configClimax.attributes.restorationAmount);
+    g_effects.RestoreActorValue(RE::ActorValue::kHealth, amount);
+    g_effects.RestoreActorValue(RE::ActorValue::kMagicka, amount);
+    g_effects.RestoreActorValue(RE::ActorValue::kStamina, amount);
     
-    auto* player = RE::PlayerCharacter::GetSingleton();
-    if (!player) return;
-    
-    auto* actorValueOwner = player->AsActorValueOwner();
-    if (actorValueOwner) {
-        float amount = static_cast<float>(g_configClimax.attributes.restorationAmount);
-        actorValueOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kDamage, RE::ActorValue::kHealth, amount);
-        actorValueOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kDamage, RE::ActorValue::kMagicka, amount);
-        actorValueOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kDamage, RE::ActorValue::kStamina, amount);
-        
-        if (g_configClimax.attributes.showNotification) {
-            std::string msg = "OSurvival Climax - Attributes restored " + std::to_string(g_configClimax.attributes.restorationAmount) + " points";
-            RE::DebugNotification(msg.c_str());
-        }
-        
-        WriteToActionsLog("Climax Attributes restore: " + std::to_string(g_configClimax.attributes.restorationAmount) + " points", __LINE__);
+    if (configClimax.attributes.showNotification) {
+        std::string msg = "OSurvival Climax - Attributes restored " + std::to_string(configClimax.attributes.restorationAmount) + " points";
+        g_effects.Notify(msg);
     }
+    
+    WriteToActionsLog("Climax Attributes restore: " + std::to_string(configClimax.attributes.restorationAmount) + " points", __LINE__);
 }
 
 void ProcessClimaxItem1Reward(const std::string& actorName, bool isPlayer) {
-    
-    RE::FormID itemFormID = GetFormIDFromPlugin(g_configClimax.item1.plugin, g_configClimax.item1.id);
+    const PluginConfigClimax& configClimax = g_configClimax.Get();
+
+    RE::FormID itemFormID = GetFormIDFromPlugin(configClimax.item1.plugin, configClimax.item1.id);
     if (itemFormID == 0) return;
     
-    auto* player = RE::PlayerCharacter::GetSingleton();
     auto* itemForm = RE::TESForm::LookupByID(itemFormID);
-    if (!player || !itemForm) return;
+    if (!itemForm) return;
     
     auto* item = itemForm->As<RE::TESBoundObject>();
     if (!item) return;
     
-    player->AddObjectToContainer(item, nullptr, g_configClimax.item1.amount, nullptr);
+    g_effects.AddItem(item, configClimax.item1.amount);
     
-    if (g_configClimax.item1.showNotification) {
-        std::string msg = "OSurvival Climax - Received " + std::to_string(g_configClimax.item1.amount) + " " + g_configClimax.item1.itemName;
-        RE::DebugNotification(msg.c_str());
+    if (configClimax.item1.showNotification) {
+        std::string msg = "OSurvival Climax - Received " + std::to_string(configClimax.item1.amount) + " " + configClimax.item1.itemName;
+        g_effects.Notify(msg);
     }
     
-    WriteToActionsLog("Climax Item1 reward: " + std::to_string(g_configClimax.item1.amount) + " " + g_configClimax.item1.itemName, __LINE__);
+    WriteToActionsLog("Climax Item1 reward: " + std::to_string(configClimax.item1.amount) + " " + configClimax.item1.itemName, __LINE__);
 }
 
 void ProcessClimaxItem2Reward(const std::string& actorName, bool isPlayer) {
-    
-    RE::FormID itemFormID = GetFormIDFromPlugin(g_configClimax.item2.plugin, g_configClimax.item2.id);
+    const PluginConfigClimax& configClimax = g_configClimax.Get();
+
+    RE::FormID itemFormID = GetFormIDFromPlugin(configClimax.item2.plugin, configClimax.item2.id);
     if (itemFormID == 0) return;
     
-    auto* player = RE::PlayerCharacter::GetSingleton();
     auto* itemForm = RE::TESForm::LookupByID(itemFormID);
-    if (!player || !itemForm) return;
+    if (!itemForm) return;
     
     auto* item = itemForm->As<RE::TESBoundObject>();
     if (!item) return;
     
-    player->AddObjectToContainer(item, nullptr, g_configClimax.item2.amount, nullptr);
+    g_effects.AddItem(item, configClimax.item2.amount);
     
-    if (g_configClimax.item2.showNotification) {
-        std::string msg = "OSurvival Climax - Received " + std::to_string(g_configClimax.item2.amount) + " " + g_configClimax.item2.itemName;
-        RE::DebugNotification(msg.c_str());
+    if (configClimax.item2.showNotification) {
+        std::string msg = "OSurvival Climax - Received " + std::to_string(configClimax.item2.amount) + " " + configClimax.item2.itemName;
+        g_effects.Notify(msg);
     }
     
-    WriteToActionsLog("Climax Item2 reward: " + std::to_string(g_configClimax.item2.amount) + " " + g_configClimax.item2.itemName, __LINE__);
+    WriteToActionsLog("Climax Item2 reward: " + std::to_string(configClimax.item2.amount) + " " + configClimax.item2.itemName, __LINE__);
 }
 
 void ProcessClimaxMilkReward(const std::string& actorName, bool isPlayer) {
-    
-    RE::FormID milkFormID = GetFormIDFromPlugin(g_configClimax.milk.plugin, g_configClimax.milk.id);
+    const PluginConfigClimax& configClimax = g_configClimax.Get();
+
+    RE::FormID milkFormID = GetFormIDFromPlugin(configClimax.milk.plugin, configClimax.milk.id);
     if (milkFormID == 0) return;
     
-    auto* player = RE::PlayerCharacter::GetSingleton();
     auto* milkForm = RE::TESForm::LookupByID(milkFormID);
-    if (!player || !milkForm) return;
+    if (!milkForm) return;
     
     auto* milkItem = milkForm->As<RE::TESBoundObject>();
     if (!milkItem) return;
     
-    player->AddObjectToContainer(milkItem, nullptr, g_configClimax.milk.amount, nullptr);
+    g_effects.AddItem(milkItem, configClimax.milk.amount);
     
-    if (g_configClimax.milk.showNotification) {
-        std::string msg = "OSurvival Climax - Received " + std::to_string(g_configClimax.milk.amount) + " Milk";
-        RE::DebugNotification(msg.c_str());
+    if (configClimax.milk.showNotification) {
+        std::string msg = "OSurvival Climax - Received " + std::to_string(configClimax.milk.amount) + " Milk";
+        g_effects.Notify(msg);
     }
     
-    WriteToActionsLog("Climax Milk reward: " + std::to_string(g_configClimax.milk.amount) + " Milk", __LINE__);
+    WriteToActionsLog("Climax Milk reward: " + std::to_string(configClimax.milk.amount) + " Milk", __LINE__);
 }
 
 void ProcessClimaxMilkWenchReward(const std::string& actorName, bool isPlayer) {
-    
-    RE::FormID milkFormID = GetFormIDFromPlugin(g_configClimax.milkWench.plugin, g_configClimax.milkWench.id);
+    const PluginConfigClimax& configClimax = g_configClimax.Get();
+
+    RE::FormID milkFormID = GetFormIDFromPlugin(configClimax.milkWench.plugin, configClimax.milkWench.id);
     if (milkFormID == 0) return;
     
-    auto* player = RE::PlayerCharacter::GetSingleton();
     auto* milkForm = RE::TESForm::LookupByID(milkFormID);
-    if (!player || !milkForm) return;
+    if (!milkForm) return;
     
     auto* milkItem = milkForm->As<RE::TESBoundObject>();
     if (!milkItem) return;
     
-    player->AddObjectToContainer(milkItem, nullptr, g_configClimax.milkWench.amount, nullptr);
+    g_effects.AddItem(milkItem, configClimax.milkWench.amount);
     
-    if (g_configClimax.milkWench.showNotification) {
-        std::string msg = "OSurvival Climax - Received " + std::to_string(g_configClimax.milkWench.amount) + " Wench Milk";
-        RE::DebugNotification(msg.c_str());
+    if (configClimax.milkWench.showNotification) {
+        std::string msg = "OSurvival Climax - Received " + std::to_string(configClimax.milkWench.amount) + " Wench Milk";
+        g_effects.Notify(msg);
     }
     
-    WriteToActionsLog("Climax Wench Milk reward: " + std::to_string(g_configClimax.milkWench.amount) + " Wench Milk", __LINE__);
+    WriteToActionsLog("Climax Wench Milk reward: " + std::to_string(configClimax.milkWench.amount) + " Wench Milk", __LINE__);
 }
 
 void ProcessClimaxMilkEthelReward(const std::string& actorName, bool isPlayer) {
-    
-    RE::FormID milkFormID = GetFormIDFromPlugin(g_configClimax.milkEthel.pluginItem, g_configClimax.milkEthel.id);
+    const PluginConfigClimax& configClimax = g_configClimax.Get();
+
+    RE::FormID milkFormID = GetFormIDFromPlugin(configClimax.milkEthel.pluginItem, configClimax.milkEthel.id);
     if (milkFormID == 0) return;
     
-    auto* player = RE::PlayerCharacter::GetSingleton();
     auto* milkForm = RE::TESForm::LookupByID(milkFormID);
-    if (!player || !milkForm) return;
+    if (!milkForm) return;
     
     auto* milkItem = milkForm->As<RE::TESBoundObject>();
     if (!milkItem) return;
     
-    player->AddObjectToContainer(milkItem, nullptr, g_configClimax.milkEthel.amount, nullptr);
+    g_effects.AddItem(milkItem, configClimax.milkEthel.amount);
     
-    if (g_configClimax.milkEthel.showNotification) {
-        std::string msg = "OSurvival Climax - Received " + std::to_string(g_configClimax.milkEthel.amount) + " Milk Ethel";
-        RE::DebugNotification(msg.c_str());
+    if (configClimax.milkEthel.showNotification) {
+        std::string msg = "OSurvival Climax - Received " + std::to_string(configClimax.milkEthel.amount) + " Milk Ethel";
+        g_effects.Notify(msg);
     }
     
-    WriteToActionsLog("Climax Milk Ethel reward: " + std::to_string(g_configClimax.milkEthel.amount) + " Milk Ethel", __LINE__);
+    WriteToActionsLog("Climax Milk Ethel reward: " + std::to_string(configClimax.milkEthel.amount) + " Milk Ethel", __LINE__);
+}
+
+bool WritePluginConfiguration(const fs::path& iniPath, const PluginConfig& config) {
+    return WriteIniText(iniPath, FormatPluginConfigText(config));
 }
 
 void SaveDefaultConfiguration() {
-    fs::path iniPath = GetPluginINIPath();
-    
-    std::ofstream iniFile(iniPath, std::ios::trunc);
-    if (!iniFile.is_open()) {
+    PluginConfig config;
+    RewardDefinition example;
+    example.name = "Example";
+    example.enabled = false;
+    config.rewards.push_back(example);
+
+    if (!WritePluginConfiguration(GetPluginINIPath(), config)) {
         logger::error("Failed to create default configuration file");
-        return;
     }
+}
 
-    iniFile << "[Gold]" << std::endl;
-    iniFile << "Enabled=true" << std::endl;
-    iniFile << "Amount=300" << std::endl;
-    iniFile << "IntervalMinutes=7" << std::endl;
-    iniFile << "ShowNotification=true" << std::endl;
-    iniFile << std::endl;
-
-    iniFile << "[Survival]" << std::endl;
-    iniFile << "Enabled=true" << std::endl;
-    iniFile << "ReductionAmount_HungerNeedValue=100" << std::endl;
-    iniFile << "ReductionAmount_ColdNeedValue=100" << std::endl;
-    iniFile << "ReductionAmount_ExhaustionNeedValue=100" << std::endl;
-    iniFile << "IntervalSeconds=60" << std::endl;
-    iniFile << "ActivationThreshold=100" << std::endl;
-    iniFile << "ShowNotification=true" << std::endl;
-    iniFile << std::endl;
-
-    iniFile << "[Attributes]" << std::endl;
-    iniFile << "Enabled=true" << std::endl;
-    iniFile << "RestorationAmount=50" << std::endl;
-    iniFile << "IntervalSeconds=120" << std::endl;
-    iniFile << "ShowNotification=true" << std::endl;
-    iniFile << std::endl;
-
-    iniFile << "[Item1]" << std::endl;
-    iniFile << "Enabled=false" << std::endl;
-    iniFile << "ItemName=none" << std::endl;
-    iniFile << "ID=xxxxxx" << std::endl;
-    iniFile << "Plugin=none" << std::endl;
-    iniFile << "Amount=1" << std::endl;
-    iniFile << "IntervalMinutes=1" << std::endl;
-    iniFile << "ShowNotification=true" << std::endl;
-    iniFile << std::endl;
-
-    iniFile << "[Item2]" << std::endl;
-    iniFile << "Enabled=false" << std::endl;
-    iniFile << "ItemName=none" << std::endl;
-    iniFile << "ID=xxxxxx" << std::endl;
-    iniFile << "Plugin=none" << std::endl;
-    iniFile << "Amount=1" << std::endl;
-    iniFile << "IntervalMinutes=1" << std::endl;
-    iniFile << "ShowNotification=true" << std::endl;
-    iniFile << std::endl;
-
-    iniFile << "[Milk]" << std::endl;
-    iniFile << "Enabled=true" << std::endl;
-    iniFile << "ID=003534" << std::endl;
-    iniFile << "Plugin=Dawnguard.esm" << std::endl;
-    iniFile << "Amount=3" << std::endl;
-    iniFile << "IntervalMinutes=3" << std::endl;
-    iniFile << "ShowNotification=true" << std::endl;
-    iniFile << std::endl;
-
-    iniFile << "[BWY_Wench_Milk]" << std::endl;
-    iniFile << "Enabled=true" << std::endl;
-    iniFile << "ID=000D73" << std::endl;
-    iniFile << "Plugin=YurianaWench.esp" << std::endl;
-    iniFile << "Amount=3" << std::endl;
-    iniFile << "IntervalMinutes=3" << std::endl;
-    iniFile << "ShowNotification=true" << std::endl;
-    iniFile << std::endl;
-
-    iniFile << "[BWY_Milk_Ethel]" << std::endl;
-    iniFile << "Enabled=true" << std::endl;
-    iniFile << "ID=65FEC3" << std::endl;
-    iniFile << "PluginItem=YurianaWench.esp" << std::endl;
-    iniFile << "NPC=576A03" << std::endl;
-    iniFile << "PluginNPC=YurianaWench.esp" << std::endl;
-    iniFile << "Amount=1" << std::endl;
-    iniFile << "IntervalMinutes=3" << std::endl;
-    iniFile << "ShowNotification=true" << std::endl;
-    iniFile << std::endl;
-
-    iniFile << "[Frostfall]" << std::endl;
-    iniFile << "Enabled=true" << std::endl;
-    iniFile << "ReductionAmount_Frost_ColdNeedValue=100" << std::endl;
-    iniFile << "IntervalSeconds=60" << std::endl;
-    iniFile << "ActivationThreshold=100" << std::endl;
-    iniFile << "ShowNotification=true" << std::endl;
-    iniFile << std::endl;
-
-    iniFile << "[Notification]" << std::endl;
-    iniFile << "Enabled=true" << std::endl;
-
-    iniFile.close();
+bool ParseConfiguration(const fs::path& iniPath, PluginConfig& config) {
+    std::string text;
+    if (!ReadIniText(iniPath, text)) {
+        logger::error("Failed to open configuration file");
+        return false;
+    }
+    ParsePluginConfigText(text, config);
+    return true;
 }
 
 bool LoadConfiguration() {
@@ -1874,449 +1386,44 @@ bool LoadConfiguration() {
         SaveDefaultConfiguration();
     }
 
-    std::ifstream iniFile(iniPath);
-    if (!iniFile.is_open()) {
-        logger::error("Failed to open configuration file");
-        return false;
+    if (!g_config.HasChanged(iniPath)) {
+        return true;
     }
 
-    std::string line;
-    std::string currentSection;
-
-    while (std::getline(iniFile, line)) {
-        line.erase(0, line.find_first_not_of(" \t\r\n"));
-        line.erase(line.find_last_not_of(" \t\r\n") + 1);
-
-        if (line.empty() || line[0] == ';' || line[0] == '#') {
-            continue;
-        }
-
-        if (line[0] == '[' && line[line.length() - 1] == ']') {
-            currentSection = line.substr(1, line.length() - 2);
-            continue;
-        }
-
-        size_t equalPos = line.find('=');
-        if (equalPos != std::string::npos) {
-            std::string key = line.substr(0, equalPos);
-            std::string value = line.substr(equalPos + 1);
-
-            key.erase(0, key.find_first_not_of(" \t"));
-            key.erase(key.find_last_not_of(" \t") + 1);
-            value.erase(0, value.find_first_not_of(" \t"));
-            value.erase(value.find_last_not_of(" \t") + 1);
-
-            if (currentSection == "Gold") {
-                if (key == "Enabled") {
-                    g_config.gold.enabled = (value == "1" || value == "true" || value == "True");
-                } else if (key == "Amount") {
-                    g_config.gold.amount = std::stoi(value);
-                } else if (key == "IntervalMinutes") {
-                    g_config.gold.intervalMinutes = std::stoi(value);
-                } else if (key == "ShowNotification") {
-                    g_config.gold.showNotification = (value == "1" || value == "true" || value == "True");
-                }
-            } else if (currentSection == "Survival") {
-                if (key == "Enabled") {
-                    g_config.survival.enabled = (value == "1" || value == "true" || value == "True");
-                } else if (key == "ReductionAmount_HungerNeedValue") {
-                    g_config.survival.reductionAmountHunger = std::stoi(value);
-                } else if (key == "ReductionAmount_ColdNeedValue") {
-                    g_config.survival.reductionAmountCold = std::stoi(value);
-                } else if (key == "ReductionAmount_ExhaustionNeedValue") {
-                    g_config.survival.reductionAmountExhaustion = std::stoi(value);
-                } else if (key == "IntervalSeconds") {
-                    g_config.survival.intervalSeconds = std::stoi(value);
-                } else if (key == "ActivationThreshold") {
-                    g_config.survival.activationThreshold = std::stoi(value);
-                } else if (key == "ShowNotification") {
-                    g_config.survival.showNotification = (value == "1" || value == "true" || value == "True");
-                }
-            } else if (currentSection == "Attributes") {
-                if (key == "Enabled") {
-                    g_config.attributes.enabled = (value == "1" || value == "true" || value == "True");
-                } else if (key == "RestorationAmount") {
-                    g_config.attributes.restorationAmount = std::stoi(value);
-                } else if (key == "IntervalSeconds") {
-                    g_config.attributes.intervalSeconds = std::stoi(value);
-                } else if (key == "ShowNotification") {
-                    g_config.attributes.showNotification = (value == "1" || value == "true" || value == "True");
-                }
-            } else if (currentSection == "Item1") {
-                if (key == "Enabled") {
-                    g_config.item1.enabled = (value == "1" || value == "true" || value == "True");
-                } else if (key == "ItemName") {
-                    g_config.item1.itemName = value;
-                } else if (key == "ID") {
-                    g_config.item1.id = value;
-                } else if (key == "Plugin") {
-                    g_config.item1.plugin = value;
-                } else if (key == "Amount") {
-                    g_config.item1.amount = std::stoi(value);
-                } else if (key == "IntervalMinutes") {
-                    g_config.item1.intervalMinutes = std::stoi(value);
-                } else if (key == "ShowNotification") {
-                    g_config.item1.showNotification = (value == "1" || value == "true" || value == "True");
-                }
-            } else if (currentSection == "Item2") {
-                if (key == "Enabled") {
-                    g_config.item2.enabled = (value == "1" || value == "true" || value == "True");
-                } else if (key == "ItemName") {
-                    g_config.item2.itemName = value;
-                } else if (key == "ID") {
-                    g_config.item2.id = value;
-                } else if (key == "Plugin") {
-                    g_config.item2.plugin = value;
-                } else if (key == "Amount") {
-                    g_config.item2.amount = std::stoi(value);
-                } else if (key == "IntervalMinutes") {
-                    g_config.item2.intervalMinutes = std::stoi(value);
-                } else if (key == "ShowNotification") {
-                    g_config.item2.showNotification = (value == "1" || value == "true" || value == "True");
-                }
-            } else if (currentSection == "Milk") {
-                if (key == "Enabled") {
-                    g_config.milk.enabled = (value == "1" || value == "true" || value == "True");
-                } else if (key == "ID") {
-                    g_config.milk.id = value;
-                } else if (key == "Plugin") {
-                    g_config.milk.plugin = value;
-                } else if (key == "Amount") {
-                    g_config.milk.amount = std::stoi(value);
-                } else if (key == "IntervalMinutes") {
-                    g_config.milk.intervalMinutes = std::stoi(value);
-                } else if (key == "ShowNotification") {
-                    g_config.milk.showNotification = (value == "1" || value == "true" || value == "True");
-                }
-            } else if (currentSection == "BWY_Wench_Milk") {
-                if (key == "Enabled") {
-                    g_config.milkWench.enabled = (value == "1" || value == "true" || value == "True");
-                } else if (key == "ID") {
-                    g_config.milkWench.id = value;
-                } else if (key == "Plugin") {
-                    g_config.milkWench.plugin = value;
-                } else if (key == "Amount") {
-                    g_config.milkWench.amount = std::stoi(value);
-                } else if (key == "IntervalMinutes") {
-                    g_config.milkWench.intervalMinutes = std::stoi(value);
-                } else if (key == "ShowNotification") {
-                    g_config.milkWench.showNotification = (value == "1" || value == "true" || value == "True");
-                }
-            } else if (currentSection == "BWY_Milk_Ethel") {
-                if (key == "Enabled") {
-                    g_config.milkEthel.enabled = (value == "1" || value == "true" || value == "True");
-                } else if (key == "ID") {
-                    g_config.milkEthel.id = value;
-                } else if (key == "PluginItem") {
-                    g_config.milkEthel.pluginItem = value;
-                } else if (key == "NPC") {
-                    g_config.milkEthel.npc = value;
-                } else if (key == "PluginNPC") {
-                    g_config.milkEthel.pluginNPC = value;
-                } else if (key == "Amount") {
-                    g_config.milkEthel.amount = std::stoi(value);
-                } else if (key == "IntervalMinutes") {
-                    g_config.milkEthel.intervalMinutes = std::stoi(value);
-                } else if (key == "ShowNotification") {
-                    g_config.milkEthel.showNotification = (value == "1" || value == "true" || value == "True");
-                }
-            } else if (currentSection == "Notification") {
-                if (key == "Enabled") {
-                    g_config.notification.enabled = (value == "1" || value == "true" || value == "True");
-                }
-            }
-        }
+    PluginConfig config;
+    if (!ParseConfiguration(iniPath, config)) {
+        g_config.Invalidate();
+        return false;
     }
 
-    iniFile.close();
+    g_config.Publish(std::move(config));
     return true;
 }
 
+bool ParseClimaxConfiguration(const fs::path& iniPath, PluginConfigClimax& configClimax) {
+    return ReadIniFile(iniPath, kClimaxConfigSchema, configClimax);
+}
+
 bool LoadClimaxConfiguration() {
     std::lock_guard<std::mutex> lock(g_configMutex);
 
     fs::path iniPath = GetPluginINIPath().parent_path() / "OSurvival-Mode-NG-Climax.ini";
 
-    if (!fs::exists(iniPath)) {
-        std::ofstream iniFile(iniPath, std::ios::trunc);
-        if (!iniFile.is_open()) {
-            return false;
-        }
-
-        iniFile << "[Gold]" << std::endl;
-        iniFile << "Enabled=true" << std::endl;
-        iniFile << "Amount=300" << std::endl;
-        iniFile << "EVENT=ostim_actor_orgasm" << std::endl;
-        iniFile << "Male=true" << std::endl;
-        iniFile << "Female=true" << std::endl;
-        iniFile << "ShowNotification=true" << std::endl;
-        iniFile << std::endl;
-
-        iniFile << "[Survival]" << std::endl;
-        iniFile << "Enabled=true" << std::endl;
-        iniFile << "ReductionAmount_HungerNeedValue=100" << std::endl;
-        iniFile << "ReductionAmount_ColdNeedValue=100" << std::endl;
-        iniFile << "ReductionAmount_ExhaustionNeedValue=100" << std::endl;
-        iniFile << "ActivationThreshold=100" << std::endl;
-        iniFile << "EVENT=ostim_actor_orgasm" << std::endl;
-        iniFile << "Male=true" << std::endl;
-        iniFile << "Female=true" << std::endl;
-        iniFile << "ShowNotification=true" << std::endl;
-        iniFile << std::endl;
-
-        iniFile << "[Attributes]" << std::endl;
-        iniFile << "Enabled=true" << std::endl;
-        iniFile << "RestorationAmount=50" << std::endl;
-        iniFile << "EVENT=ostim_actor_orgasm" << std::endl;
-        iniFile << "Male=true" << std::endl;
-        iniFile << "Female=true" << std::endl;
-        iniFile << "ShowNotification=true" << std::endl;
-        iniFile << std::endl;
-
-        iniFile << "[Item1]" << std::endl;
-        iniFile << "Enabled=false" << std::endl;
-        iniFile << "ItemName=none" << std::endl;
-        iniFile << "ID=xxxxxx" << std::endl;
-        iniFile << "Plugin=none" << std::endl;
-        iniFile << "Amount=1" << std::endl;
-        iniFile << "EVENT=ostim_actor_orgasm" << std::endl;
-        iniFile << "Male=true" << std::endl;
-        iniFile << "Female=true" << std::endl;
-        iniFile << "ShowNotification=true" << std::endl;
-        iniFile << std::endl;
-
-        iniFile << "[Item2]" << std::endl;
-        iniFile << "Enabled=false" << std::endl;
-        iniFile << "ItemName=none" << std::endl;
-        iniFile << "ID=xxxxxx" << std::endl;
-        iniFile << "Plugin=none" << std::endl;
-        iniFile << "Amount=1" << std::endl;
-        iniFile << "EVENT=ostim_actor_orgasm" << std::endl;
-        iniFile << "Male=true" << std::endl;
-        iniFile << "Female=true" << std::endl;
-        iniFile << "ShowNotification=true" << std::endl;
-        iniFile << std::endl;
-
-        iniFile << "[Milk]" << std::endl;
-        iniFile << "Enabled=false" << std::endl;
-        iniFile << "ID=003534" << std::endl;
-        iniFile << "Plugin=HearthFires.esm" << std::endl;
-        iniFile << "Amount=1" << std::endl;
-        iniFile << "EVENT=ostim_actor_orgasm" << std::endl;
-        iniFile << "Male=true" << std::endl;
-        iniFile << "Female=true" << std::endl;
-        iniFile << "ShowNotification=true" << std::endl;
-        iniFile << std::endl;
-
-        iniFile << "[BWY_Wench_Milk]" << std::endl;
-        iniFile << "Enabled=false" << std::endl;
-        iniFile << "ID=000D73" << std::endl;
-        iniFile << "Plugin=YurianaWench.esp" << std::endl;
-        iniFile << "Amount=1" << std::endl;
-        iniFile << "EVENT=ostim_actor_orgasm" << std::endl;
-        iniFile << "Male=true" << std::endl;
-        iniFile << "Female=true" << std::endl;
-        iniFile << "ShowNotification=true" << std::endl;
-        iniFile << std::endl;
-
-        iniFile << "[BWY_Milk_Ethel]" << std::endl;
-        iniFile << "Enabled=false" << std::endl;
-        iniFile << "ID=65FEC3" << std::endl;
-        iniFile << "PluginItem=YurianaWench.esp" << std::endl;
-        iniFile << "NPC=576A03" << std::endl;
-        iniFile << "PluginNPC=YurianaWench.esp" << std::endl;
-        iniFile << "Amount=1" << std::endl;
-        iniFile << "EVENT=ostim_actor_orgasm" << std::endl;
-        iniFile << "Male=true" << std::endl;
-        iniFile << "Female=true" << std::endl;
-        iniFile << "ShowNotification=true" << std::endl;
-        iniFile << std::endl;
-
-        iniFile.close();
-    }
-
-    std::ifstream iniFile(iniPath);
-    if (!iniFile.is_open()) {
+    if (!fs::exists(iniPath) && !WriteIniFile(iniPath, kClimaxConfigSchema, PluginConfigClimax{})) {
         return false;
     }
 
-    std::string line;
-    std::string currentSection;
-
-    while (std::getline(iniFile, line)) {
-        line.erase(0, line.find_first_not_of(" \t\r\n"));
-        line.erase(line.find_last_not_of(" \t\r\n") + 1);
-
-        if (line.empty() || line[0] == ';' || line[0] == '#') {
-            continue;
-        }
-
-        if (line[0] == '[' && line[line.length() - 1] == ']') {
-            currentSection = line.substr(1, line.length() - 2);
-            continue;
-        }
+    if (!g_configClimax.HasChanged(iniPath)) {
+        return true;
+    }
 
-        size_t equalPos = line.find('=');
-        if (equalPos != std::string::npos) {
-            std::string key = line.substr(0, equalPos);
-            std::string value = line.substr(equalPos + 1);
-
-            key.erase(0, key.find_first_not_of(" \t"));
-            key.erase(key.find_last_not_of(" \t") + 1);
-            value.erase(0, value.find_first_not_of(" \t"));
-            value.erase(value.find_last_not_of(" \t") + 1);
-
-            if (currentSection == "Gold") {
-                if (key == "Enabled") {
-                    g_configClimax.gold.enabled = (value == "1" || value == "true" || value == "True");
-                } else if (key == "Amount") {
-                    g_configClimax.gold.amount = std::stoi(value);
-                } else if (key == "EVENT") {
-                    g_configClimax.gold.event = value;
-                } else if (key == "Male") {
-                    g_configClimax.gold.male = (value == "1" || value == "true" || value == "True");
-                } else if (key == "Female") {
-                    g_configClimax.gold.female = (value == "1" || value == "true" || value == "True");
-                } else if (key == "ShowNotification") {
-                    g_configClimax.gold.showNotification = (value == "1" || value == "true" || value == "True");
-                }
-            } else if (currentSection == "Survival") {
-                if (key == "Enabled") {
-                    g_configClimax.survival.enabled = (value == "1" || value == "true" || value == "True");
-                } else if (key == "ReductionAmount_HungerNeedValue") {
-                    g_configClimax.survival.reductionAmountHunger = std::stoi(value);
-                } else if (key == "ReductionAmount_ColdNeedValue") {
-                    g_configClimax.survival.reductionAmountCold = std::stoi(value);
-                } else if (key == "ReductionAmount_ExhaustionNeedValue") {
-                    g_configClimax.survival.reductionAmountExhaustion = std::stoi(value);
-                } else if (key == "ActivationThreshold") {
-                    g_configClimax.survival.activationThreshold = std::stoi(value);
-                } else if (key == "EVENT") {
-                    g_configClimax.survival.event = value;
-                } else if (key == "Male") {
-                    g_configClimax.survival.male = (value == "1" || value == "true" || value == "True");
-                } else if (key == "Female") {
-                    g_configClimax.survival.female = (value == "1" || value == "true" || value == "True");
-                } else if (key == "ShowNotification") {
-                    g_configClimax.survival.showNotification = (value == "1" || value == "true" || value == "True");
-                }
-            } else if (currentSection == "Attributes") {
-                if (key == "Enabled") {
-                    g_configClimax.attributes.enabled = (value == "1" || value == "true" || value == "True");
-                } else if (key == "RestorationAmount") {
-                    g_configClimax.attributes.restorationAmount = std::stoi(value);
-                } else if (key == "EVENT") {
-                    g_configClimax.attributes.event = value;
-                } else if (key == "Male") {
-                    g_configClimax.attributes.male = (value == "1" || value == "true" || value == "True");
-                } else if (key == "Female") {
-                    g_configClimax.attributes.female = (value == "1" || value == "true" || value == "True");
-                } else if (key == "ShowNotification") {
-                    g_configClimax.attributes.showNotification = (value == "1" || value == "true" || value == "True");
-                }
-            } else if (currentSection == "Item1") {
-                if (key == "Enabled") {
-                    g_configClimax.item1.enabled = (value == "1" || value == "true" || value == "True");
-                } else if (key == "ItemName") {
-                    g_configClimax.item1.itemName = value;
-                } else if (key == "ID") {
-                    g_configClimax.item1.id = value;
-                } else if (key == "Plugin") {
-                    g_configClimax.item1.plugin = value;
-                } else if (key == "Amount") {
-                    g_configClimax.item1.amount = std::stoi(value);
-                } else if (key == "EVENT") {
-                    g_configClimax.item1.event = value;
-                } else if (key == "Male") {
-                    g_configClimax.item1.male = (value == "1" || value == "true" || value == "True");
-                } else if (key == "Female") {
-                    g_configClimax.item1.female = (value == "1" || value == "true" || value == "True");
-                } else if (key == "ShowNotification") {
-                    g_configClimax.item1.showNotification = (value == "1" || value == "true" || value == "True");
-                }
-            } else if (currentSection == "Item2") {
-                if (key == "Enabled") {
-                    g_configClimax.item2.enabled = (value == "1" || value == "true" || value == "True");
-                } else if (key == "ItemName") {
-                    g_configClimax.item2.itemName = value;
-                } else if (key == "ID") {
-                    g_configClimax.item2.id = value;
-                } else if (key == "Plugin") {
-                    g_configClimax.item2.plugin = value;
-                } else if (key == "Amount") {
-                    g_configClimax.item2.amount = std::stoi(value);
-                } else if (key == "EVENT") {
-                    g_configClimax.item2.event = value;
-                } else if (key == "Male") {
-                    g_configClimax.item2.male = (value == "1" || value == "true" || value == "True");
-                } else if (key == "Female") {
-                    g_configClimax.item2.female = (value == "1" || value == "true" || value == "True");
-                } else if (key == "ShowNotification") {
-                    g_configClimax.item2.showNotification = (value == "1" || value == "true" || value == "True");
-                }
-            } else if (currentSection == "Milk") {
-                if (key == "Enabled") {
-                    g_configClimax.milk.enabled = (value == "1" || value == "true" || value == "True");
-                } else if (key == "ID") {
-                    g_configClimax.milk.id = value;
-                } else if (key == "Plugin") {
-                    g_configClimax.milk.plugin = value;
-                } else if (key == "Amount") {
-                    g_configClimax.milk.amount = std::stoi(value);
-                } else if (key == "EVENT") {
-                    g_configClimax.milk.event = value;
-                } else if (key == "Male") {
-                    g_configClimax.milk.male = (value == "1" || value == "true" || value == "True");
-                } else if (key == "Female") {
-                    g_configClimax.milk.female = (value == "1" || value == "true" || value == "True");
-                } else if (key == "ShowNotification") {
-                    g_configClimax.milk.showNotification = (value == "1" || value == "true" || value == "True");
-                }
-            } else if (currentSection == "BWY_Wench_Milk") {
-                if (key == "Enabled") {
-                    g_configClimax.milkWench.enabled = (value == "1" || value == "true" || value == "True");
-                } else if (key == "ID") {
-                    g_configClimax.milkWench.id = value;
-                } else if (key == "Plugin") {
-                    g_configClimax.milkWench.plugin = value;
-                } else if (key == "Amount") {
-                    g_configClimax.milkWench.amount = std::stoi(value);
-                } else if (key == "EVENT") {
-                    g_configClimax.milkWench.event = value;
-                } else if (key == "Male") {
-                    g_configClimax.milkWench.male = (value == "1" || value == "true" || value == "True");
-                } else if (key == "Female") {
-                    g_configClimax.milkWench.female = (value == "1" || value == "true" || value == "True");
-                } else if (key == "ShowNotification") {
-                    g_configClimax.milkWench.showNotification = (value == "1" || value == "true" || value == "True");
-                }
-            } else if (currentSection == "BWY_Milk_Ethel") {
-                if (key == "Enabled") {
-                    g_configClimax.milkEthel.enabled = (value == "1" || value == "true" || value == "True");
-                } else if (key == "ID") {
-                    g_configClimax.milkEthel.id = value;
-                } else if (key == "PluginItem") {
-                    g_configClimax.milkEthel.pluginItem = value;
-                } else if (key == "NPC") {
-                    g_configClimax.milkEthel.npc = value;
-                } else if (key == "PluginNPC") {
-                    g_configClimax.milkEthel.pluginNPC = value;
-                } else if (key == "Amount") {
-                    g_configClimax.milkEthel.amount = std::stoi(value);
-                } else if (key == "EVENT") {
-                    g_configClimax.milkEthel.event = value;
-                } else if (key == "Male") {
-                    g_configClimax.milkEthel.male = (value == "1" || value == "true" || value == "True");
-                } else if (key == "Female") {
-                    g_configClimax.milkEthel.female = (value == "1" || value == "true" || value == "True");
-                } else if (key == "ShowNotification") {
-                    g_configClimax.milkEthel.showNotification = (value == "1" || value == "true" || value == "True");
-                }
-            }
-        }
+    PluginConfigClimax configClimax;
+    if (!ParseClimaxConfiguration(iniPath, configClimax)) {
+        g_configClimax.Invalidate();
+        return false;
     }
 
-    iniFile.close();
+    g_configClimax.Publish(std::move(configClimax));
     return true;
 }
 
@@ -2326,294 +1433,161 @@ void ValidateAndUpdatePluginsInINI() {
         return;
     }
 
+    LoadConfiguration();
+
+    std::lock_guard<std::mutex> lock(g_configMutex);
+
     bool needsUpdate = false;
-    PluginConfig originalConfig = g_config;
+    PluginConfig config = g_config.Get();
 
-    if (g_config.item1.enabled) {
-        if (g_config.item1.plugin != "none") {
-            auto* item1Plugin = dataHandler->LookupModByName(g_config.item1.plugin);
-            if (!item1Plugin) {
-                g_config.item1.enabled = false;
+    if (config.item1.enabled) {
+        if (config.item1.plugin != "none") {
+            if (!GetPluginIndex(config.item1.plugin).present) {
+                config.item1.enabled = false;
                 needsUpdate = true;
-                WriteToActionsLog("Plugin not found: " + g_config.item1.plugin + " - Disabled [Item1] in INI", __LINE__);
+                WriteToActionsLog("Plugin not found: " + config.item1.plugin + " - Disabled [Item1] in INI", __LINE__);
             }
         }
     }
 
-    if (g_config.item2.enabled) {
-        if (g_config.item2.plugin != "none") {
-            auto* item2Plugin = dataHandler->LookupModByName(g_config.item2.plugin);
-            if (!item2Plugin) {
-                g_config.item2.enabled = false;
+    if (config.item2.enabled) {
+        if (config.item2.plugin != "none") {
+            if (!GetPluginIndex(config.item2.plugin).present) {
+                config.item2.enabled = false;
                 needsUpdate = true;
-                WriteToActionsLog("Plugin not found: " + g_config.item2.plugin + " - Disabled [Item2] in INI", __LINE__);
+                WriteToActionsLog("Plugin not found: " + config.item2.plugin + " - Disabled [Item2] in INI", __LINE__);
             }
         }
     }
 
-    if (g_config.milk.enabled) {
-        auto* milkPlugin = dataHandler->LookupModByName(g_config.milk.plugin);
-        if (!milkPlugin) {
-            g_config.milk.enabled = false;
+    if (config.milk.enabled) {
+        if (!GetPluginIndex(config.milk.plugin).present) {
+            config.milk.enabled = false;
             needsUpdate = true;
-            WriteToActionsLog("Plugin not found: " + g_config.milk.plugin + " - Disabled [Milk] in INI", __LINE__);
+            WriteToActionsLog("Plugin not found: " + config.milk.plugin + " - Disabled [Milk] in INI", __LINE__);
         }
     }
 
-    if (g_config.milkWench.enabled) {
-        auto* wenchPlugin = dataHandler->LookupModByName(g_config.milkWench.plugin);
-        if (!wenchPlugin) {
-            g_config.milkWench.enabled = false;
+    if (config.milkWench.enabled) {
+        if (!GetPluginIndex(config.milkWench.plugin).present) {
+            config.milkWench.enabled = false;
             needsUpdate = true;
-            WriteToActionsLog("Plugin not found: " + g_config.milkWench.plugin + " - Disabled [BWY_Wench_Milk] in INI", __LINE__);
+            WriteToActionsLog("Plugin not found: " + config.milkWench.plugin + " - Disabled [BWY_Wench_Milk] in INI", __LINE__);
         }
     }
 
-    if (g_config.milkEthel.enabled) {
-        auto* ethelPluginItem = dataHandler->LookupModByName(g_config.milkEthel.pluginItem);
-        auto* ethelPluginNPC = dataHandler->LookupModByName(g_config.milkEthel.pluginNPC);
-        if (!ethelPluginItem || !ethelPluginNPC) {
-            g_config.milkEthel.enabled = false;
+    if (config.milkEthel.enabled) {
+        if (!GetPluginIndex(config.milkEthel.pluginItem).present || !GetPluginIndex(config.milkEthel.pluginNPC).present) {
+            config.milkEthel.enabled = false;
             needsUpdate = true;
             WriteToActionsLog("Plugin not found for Ethel - Disabled [BWY_Milk_Ethel] in INI", __LINE__);
         }
     }
 
-    if (needsUpdate) {
-        fs::path iniPath = GetPluginINIPath();
-        std::ofstream iniFile(iniPath, std::ios::trunc);
-        if (!iniFile.is_open()) {
-            return;
+    for (auto& reward : config.rewards) {
+        if (reward.enabled && reward.plugin != "none" && !GetPluginIndex(reward.plugin).present) {
+            reward.enabled = false;
+            needsUpdate = true;
+            WriteToActionsLog("Plugin not found: " + reward.plugin + " - Disabled [" + std::string(kRewardSectionPrefix) +
+                                  reward.name + "] in INI",
+                              __LINE__);
         }
-
-        iniFile << "[Gold]" << std::endl;
-        iniFile << "Enabled=" << (g_config.gold.enabled ? "true" : "false") << std::endl;
-        iniFile << "Amount=" << g_config.gold.amount << std::endl;
-        iniFile << "IntervalMinutes=" << g_config.gold.intervalMinutes << std::endl;
-        iniFile << "ShowNotification=" << (g_config.gold.showNotification ? "true" : "false") << std::endl;
-        iniFile << std::endl;
-
-        iniFile << "[Survival]" << std::endl;
-        iniFile << "Enabled=" << (g_config.survival.enabled ? "true" : "false") << std::endl;
-        iniFile << "ReductionAmount_HungerNeedValue=" << g_config.survival.reductionAmountHunger << std::endl;
-        iniFile << "ReductionAmount_ColdNeedValue=" << g_config.survival.reductionAmountCold << std::endl;
-        iniFile << "ReductionAmount_ExhaustionNeedValue=" << g_config.survival.reductionAmountExhaustion << std::endl;
-        iniFile << "IntervalSeconds=" << g_config.survival.intervalSeconds << std::endl;
-        iniFile << "ActivationThreshold=" << g_config.survival.activationThreshold << std::endl;
-        iniFile << "ShowNotification=" << (g_config.survival.showNotification ? "true" : "false") << std::endl;
-        iniFile << std::endl;
-
-        iniFile << "[Attributes]" << std::endl;
-        iniFile << "Enabled=" << (g_config.attributes.enabled ? "true" : "false") << std::endl;
-        iniFile << "RestorationAmount=" << g_config.attributes.restorationAmount << std::endl;
-        iniFile << "IntervalSeconds=" << g_config.attributes.intervalSeconds << std::endl;
-        iniFile << "ShowNotification=" << (g_config.attributes.showNotification ? "true" : "false") << std::endl;
-        iniFile << std::endl;
-
-        iniFile << "[Item1]" << std::endl;
-        iniFile << "Enabled=" << (g_config.item1.enabled ? "true" : "false") << std::endl;
-        iniFile << "ItemName=" << g_config.item1.itemName << std::endl;
-        iniFile << "ID=" << g_config.item1.id << std::endl;
-        iniFile << "Plugin=" << g_config.item1.plugin << std::endl;
-        iniFile << "Amount=" << g_config.item1.amount << std::endl;
-        iniFile << "IntervalMinutes=" << g_config.item1.intervalMinutes << std::endl;
-        iniFile << "ShowNotification=" << (g_config.item1.showNotification ? "true" : "false") << std::endl;
-        iniFile << std::endl;
-
-        iniFile << "[Item2]" << std::endl;
-        iniFile << "Enabled=" << (g_config.item2.enabled ? "true" : "false") << std::endl;
-        iniFile << "ItemName=" << g_config.item2.itemName << std::endl;
-        iniFile << "ID=" << g_config.item2.id << std::endl;
-        iniFile << "Plugin=" << g_config.item2.plugin << std::endl;
-        iniFile << "Amount=" << g_config.item2.amount << std::endl;
-        iniFile << "IntervalMinutes=" << g_config.item2.intervalMinutes << std::endl;
-        iniFile << "ShowNotification=" << (g_config.item2.showNotification ? "true" : "false") << std::endl;
-        iniFile << std::endl;
-
-        iniFile << "[Milk]" << std::endl;
-        iniFile << "Enabled=" << (g_config.milk.enabled ? "true" : "false") << std::endl;
-        iniFile << "ID=" << g_config.milk.id << std::endl;
-        iniFile << "Plugin=" << g_config.milk.plugin << std::endl;
-        iniFile << "Amount=" << g_config.milk.amount << std::endl;
-        iniFile << "IntervalMinutes=" << g_config.milk.intervalMinutes << std::endl;
-        iniFile << "ShowNotification=" << (g_config.milk.showNotification ? "true" : "false") << std::endl;
-        iniFile << std::endl;
-
-        iniFile << "[BWY_Wench_Milk]" << std::endl;
-        iniFile << "Enabled=" << (g_config.milkWench.enabled ? "true" : "false") << std::endl;
-        iniFile << "ID=" << g_config.milkWench.id << std::endl;
-        iniFile << "Plugin=" << g_config.milkWench.plugin << std::endl;
-        iniFile << "Amount=" << g_config.milkWench.amount << std::endl;
-        iniFile << "IntervalMinutes=" << g_config.milkWench.intervalMinutes << std::endl;
-        iniFile << "ShowNotification=" << (g_config.milkWench.showNotification ? "true" : "false") << std::endl;
-        iniFile << std::endl;
-
-        iniFile << "[BWY_Milk_Ethel]" << std::endl;
-        iniFile << "Enabled=" << (g_config.milkEthel.enabled ? "true" : "false") << std::endl;
-        iniFile << "ID=" << g_config.milkEthel.id << std::endl;
-        iniFile << "PluginItem=" << g_config.milkEthel.pluginItem << std::endl;
-        iniFile << "NPC=" << g_config.milkEthel.npc << std::endl;
-        iniFile << "PluginNPC=" << g_config.milkEthel.pluginNPC << std::endl;
-        iniFile << "Amount=" << g_config.milkEthel.amount << std::endl;
-        iniFile << "IntervalMinutes=" << g_config.milkEthel.intervalMinutes << std::endl;
-        iniFile << "ShowNotification=" << (g_config.milkEthel.showNotification ? "true" : "false") << std::endl;
-        iniFile << std::endl;
-
-        iniFile << "[Frostfall]" << std::endl;
-        iniFile << "Enabled=true" << std::endl;
-        iniFile << "ReductionAmount_Frost_ColdNeedValue=100" << std::endl;
-        iniFile << "IntervalSeconds=60" << std::endl;
-        iniFile << "ActivationThreshold=100" << std::endl;
-        iniFile << "ShowNotification=true" << std::endl;
-        iniFile << std::endl;
-
-        iniFile << "[Notification]" << std::endl;
-        iniFile << "Enabled=" << (g_config.notification.enabled ? "true" : "false") << std::endl;
-
-        iniFile.close();
-    }
-}
-
-void ResolveItemFormIDs() {
-    if (g_cachedItemFormIDs.resolved) {
-        return;
     }
-    
-    if (g_config.item1.enabled && g_config.item1.plugin != "none" && g_config.item1.id != "xxxxxx") {
-        g_cachedItemFormIDs.item1 = GetFormIDFromPlugin(g_config.item1.plugin, g_config.item1.id);
-        if (g_cachedItemFormIDs.item1 != 0) {
-            WriteToActionsLog("Item1 (" + g_config.item1.itemName + ") resolved successfully - FormID: 0x" + 
-                std::to_string(g_cachedItemFormIDs.item1), __LINE__);
-        } else {
-            WriteToActionsLog("WARNING: Item1 (" + g_config.item1.itemName + ") FormID resolution failed", __LINE__);
-        }
+
+    if (needsUpdate) {
+        g_config.Publish(config);
+
+        WritePluginConfiguration(GetPluginINIPath(), config);
     }
-    
-    if (g_config.item2.enabled && g_config.item2.plugin != "none" && g_config.item2.id != "xxxxxx") {
-        g_cachedItemFormIDs.item2 = GetFormIDFromPlugin(g_config.item2.plugin, g_config.item2.id);
-        if (g_cachedItemFormIDs.item2 != 0) {
-            WriteToActionsLog("Item2 (" + g_config.item2.itemName + ") resolved successfully - FormID: 0x" + 
-                std::to_string(g_cachedItemFormIDs.item2), __LINE__);
-        } else {
-            WriteToActionsLog("WARNING: Item2 (" + g_config.item2.itemName + ") FormID resolution failed", __LINE__);
-        }
+}
+
+// Rebuilds the reward table whenever a new configuration snapshot was published. Each item
+// is looked up once here; a reward whose item cannot be resolved is logged and left out.
+void RefreshRewardTable() {
+    const PluginConfig& config = g_config.Get();
+    if (g_rewardTableSource == &config) {
+        return;
     }
-    
-    if (g_config.milk.enabled) {
-        g_cachedItemFormIDs.milkDawnguard = GetFormIDFromPlugin(g_config.milk.plugin, g_config.milk.id);
-        if (g_cachedItemFormIDs.milkDawnguard != 0) {
-            WriteToActionsLog("Milk (Dawnguard) resolved successfully - FormID: 0x" + 
-                std::to_string(g_cachedItemFormIDs.milkDawnguard), __LINE__);
-        } else {
-            WriteToActionsLog("WARNING: Milk (Dawnguard) FormID resolution failed", __LINE__);
+    g_rewardTableSource = &config;
+    g_rewardTable.Clear();
+
+    auto now = std::chrono::steady_clock::now();
+    for (const auto& reward : CollectRewardDefinitions(config)) {
+        if (!reward.enabled || reward.plugin == "none" || reward.id == "xxxxxx") {
+            continue;
         }
-    }
-    
-    if (g_config.milkWench.enabled) {
-        g_cachedItemFormIDs.milkWench = GetFormIDFromPlugin(g_config.milkWench.plugin, g_config.milkWench.id);
-        if (g_cachedItemFormIDs.milkWench != 0) {
-            WriteToActionsLog("Wench Milk resolved successfully - FormID: 0x" + 
-                std::to_string(g_cachedItemFormIDs.milkWench), __LINE__);
-        } else {
-            WriteToActionsLog("WARNING: Wench Milk FormID resolution failed", __LINE__);
+
+        std::string label = reward.itemName != "none" ? reward.itemName : reward.name;
+        RewardCondition condition = ParseRewardCondition(reward.requiresNearby);
+        if (condition == RewardCondition::kInvalid) {
+            WriteToActionsLog("WARNING: " + reward.name + " - unknown RequiresNearby value: " + reward.requiresNearby,
+                              __LINE__);
+            continue;
         }
-    }
-    
-    if (g_config.milkEthel.enabled) {
-        g_cachedItemFormIDs.milkEthel = GetFormIDFromPlugin(g_config.milkEthel.pluginItem, g_config.milkEthel.id);
-        if (g_cachedItemFormIDs.milkEthel != 0) {
-            WriteToActionsLog("Milk (Ethel) resolved successfully - FormID: 0x" + 
-                std::to_string(g_cachedItemFormIDs.milkEthel), __LINE__);
-        } else {
-            WriteToActionsLog("WARNING: Milk (Ethel) FormID resolution failed", __LINE__);
+
+        RE::FormID formID = GetFormIDFromPlugin(reward.plugin, reward.id);
+        auto* item = formID != 0 ? RE::TESForm::LookupByID<RE::TESBoundObject>(formID) : nullptr;
+        if (!item) {
+            WriteToActionsLog("WARNING: " + reward.name + " (" + label + ") FormID resolution failed", __LINE__);
+            continue;
         }
+
+        g_rewardTable.Add({label, item, reward.amount, std::chrono::minutes(reward.intervalMinutes), condition,
+                           reward.showNotification, now});
+        WriteToActionsLog(reward.name + " (" + label + ") resolved successfully - FormID: 0x" + std::to_string(formID),
+                          __LINE__);
     }
-    
-    g_cachedItemFormIDs.resolved = true;
 }
 
 void TryCaptureNPCFormIDs() {
-    auto* player = RE::PlayerCharacter::GetSingleton();
-    if (!player) return;
-    
-    auto* processLists = RE::ProcessLists::GetSingleton();
-    if (!processLists) return;
+    const PluginConfig& config = g_config.Get();
+
+    RefreshActorSnapshot();
     
-    RE::NiPoint3 playerPos = player->GetPosition();
-    auto* dataHandler = RE::TESDataHandler::GetSingleton();
-    if (!dataHandler) return;
-    
-    if (g_config.milkWench.enabled && !g_capturedYurianaWenchNPC.captured) {
-        auto* file = dataHandler->LookupModByName(g_config.milkWench.plugin);
-        if (file) {
-            uint8_t modIndex = file->compileIndex;
-            if (modIndex == 0xFF) {
-                modIndex = file->smallFileCompileIndex;
-            }
+    if (config.milkWench.enabled && !g_capturedYurianaWenchNPC.captured) {
+        PluginIndex plugin = GetPluginIndex(config.milkWench.plugin);
+        if (plugin.present) {
+            std::lock_guard<std::mutex> lock(g_actorSnapshotMutex);
+            std::size_t index = g_actorSnapshot.FindInPlugin(plugin, kNearbyNPCRadius);
             
-            for (auto& actorHandle : processLists->highActorHandles) {
-                auto actor = actorHandle.get();
-                if (!actor) continue;
-                
-                auto* actorBase = actor->GetActorBase();
-                if (!actorBase) continue;
+            if (index != ActorSnapshot::npos) {
+                g_capturedYurianaWenchNPC.formID = g_actorSnapshot.BaseID(index);
+                g_capturedYurianaWenchNPC.pluginName = config.milkWench.plugin;
+                g_capturedYurianaWenchNPC.captured = true;
+                g_capturedYurianaWenchNPC.lastSeen = std::chrono::steady_clock::now();
                 
-                uint8_t npcModIndex = (actorBase->formID >> 24) & 0xFF;
-                if (npcModIndex == modIndex) {
-                    RE::NiPoint3 npcPos = actor->GetPosition();
-                    float distance = playerPos.GetDistance(npcPos);
-                    
-                    if (distance <= 500.0f) {
-                        g_capturedYurianaWenchNPC.formID = actorBase->formID;
-                        g_capturedYurianaWenchNPC.pluginName = g_config.milkWench.plugin;
-                        g_capturedYurianaWenchNPC.captured = true;
-                        g_capturedYurianaWenchNPC.lastSeen = std::chrono::steady_clock::now();
-                        
-                        WriteToActionsLog("Auto-captured YurianaWench NPC", __LINE__);
-                        break;
-                    }
-                }
+                WriteToActionsLog("Auto-captured YurianaWench NPC", __LINE__);
             }
         }
     }
     
-    if (g_config.milkEthel.enabled && !g_capturedEthelNPC.captured) {
-        std::string cleanID = g_config.milkEthel.npc;
+    if (config.milkEthel.enabled && !g_capturedEthelNPC.captured) {
+        std::string cleanID = config.milkEthel.npc;
         
         if (cleanID.length() >= 2 && cleanID.substr(0, 2) == "XX") {
             cleanID = cleanID.substr(2);
         }
         
-        RE::FormID targetFormID = GetFormIDFromPlugin(g_config.milkEthel.pluginNPC, cleanID);
+        RE::FormID targetFormID = GetFormIDFromPlugin(config.milkEthel.pluginNPC, cleanID);
         
         if (targetFormID != 0) {
-            for (auto& actorHandle : processLists->highActorHandles) {
-                auto actor = actorHandle.get();
-                if (!actor) continue;
-                
-                auto* actorBase = actor->GetActorBase();
-                if (!actorBase) continue;
+            std::lock_guard<std::mutex> lock(g_actorSnapshotMutex);
+            
+            if (g_actorSnapshot.FindByBaseID(targetFormID, kNearbyNPCRadius) != ActorSnapshot::npos) {
+                g_capturedEthelNPC.formID = targetFormID;
+                g_capturedEthelNPC.pluginName = config.milkEthel.pluginNPC;
+                g_capturedEthelNPC.captured = true;
+                g_capturedEthelNPC.lastSeen = std::chrono::steady_clock::now();
                 
-                if (actorBase->formID == targetFormID) {
-                    RE::NiPoint3 npcPos = actor->GetPosition();
-                    float distance = playerPos.GetDistance(npcPos);
-                    
-                    if (distance <= 500.0f) {
-                        g_capturedEthelNPC.formID = targetFormID;
-                        g_capturedEthelNPC.pluginName = g_config.milkEthel.pluginNPC;
-                        g_capturedEthelNPC.captured = true;
-                        g_capturedEthelNPC.lastSeen = std::chrono::steady_clock::now();
-                        
-                        WriteToActionsLog("Auto-captured Ethel NPC", __LINE__);
-                        break;
-                    }
-                }
+                WriteToActionsLog("Auto-captured Ethel NPC", __LINE__);
             }
         }
     }
 }
 
 void CheckForNearbyNPCs() {
+    const PluginConfig& config = g_config.Get();
+
     if (!IsInOStimScene()) {
         if (g_wenchMilkNPCDetected || g_ethelNPCDetected) {
             g_wenchMilkNPCDetected = false;
@@ -2633,23 +1607,23 @@ void CheckForNearbyNPCs() {
     
     TryCaptureNPCFormIDs();
     
-    if (g_config.milkWench.enabled) {
+    if (config.milkWench.enabled) {
         bool isNearby = false;
         
         if (g_capturedYurianaWenchNPC.captured) {
-            isNearby = IsSpecificNPCNearPlayer(g_capturedYurianaWenchNPC.formID, 500.0f);
+            isNearby = IsSpecificNPCNearPlayer(g_capturedYurianaWenchNPC.formID, kNearbyNPCRadius);
             
             if (isNearby) {
                 g_capturedYurianaWenchNPC.lastSeen = now;
             }
         } else {
-            isNearby = IsAnyNPCFromPluginNearPlayer(g_config.milkWench.plugin, 500.0f);
+            isNearby = IsAnyNPCFromPluginNearPlayer(config.milkWench.plugin, kNearbyNPCRadius);
         }
         
         if (isNearby && !g_wenchMilkNPCDetected) {
             g_wenchMilkNPCDetected = true;
-            if (g_config.notification.enabled && g_config.milkWench.showNotification) {
-                RE::DebugNotification("OSurvival - You have a wench nearby who will assist you on this cold evening");
+            if (config.notification.enabled && config.milkWench.showNotification) {
+                g_effects.Notify("OSurvival - You have a wench nearby who will assist you on this cold evening");
             }
             WriteToActionsLog("YurianaWench NPC detected nearby (Wench Milk eligible)", __LINE__);
         } else if (!isNearby && g_wenchMilkNPCDetected) {
@@ -2658,11 +1632,11 @@ void CheckForNearbyNPCs() {
         }
     }
     
-    if (g_config.milkEthel.enabled) {
+    if (config.milkEthel.enabled) {
         bool isNearby = false;
         
         if (g_capturedEthelNPC.captured) {
-            isNearby = IsSpecificNPCNearPlayer(g_capturedEthelNPC.formID, 500.0f);
+            isNearby = IsSpecificNPCNearPlayer(g_capturedEthelNPC.formID, kNearbyNPCRadius);
             
             if (isNearby) {
                 g_capturedEthelNPC.lastSeen = now;
@@ -2671,8 +1645,8 @@ void CheckForNearbyNPCs() {
         
         if (isNearby && !g_ethelNPCDetected) {
             g_ethelNPCDetected = true;
-            if (g_config.notification.enabled && g_config.milkEthel.showNotification) {
-                RE::DebugNotification("OSurvival - Ethel the Cute little Cow is with you!");
+            if (config.notification.enabled && config.milkEthel.showNotification) {
+                g_effects.Notify("OSurvival - Ethel the Cute little Cow is with you!");
             }
             WriteToActionsLog("Ethel NPC detected nearby (Milk Ethel eligible)", __LINE__);
         } else if (!isNearby && g_ethelNPCDetected) {
@@ -2683,356 +1657,153 @@ void CheckForNearbyNPCs() {
 }
 
 void CheckAndRewardGold() {
-    LoadConfiguration();
+    const PluginConfig& config = g_config.Get();
 
-    if (!g_config.gold.enabled || !IsInOStimScene() || GetLastAnimation().empty()) {
+    if (!config.gold.enabled || !IsInOStimScene() || GetLastAnimation().empty()) {
         return;
     }
 
     auto now = std::chrono::steady_clock::now();
     auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - g_lastGoldRewardTime).count();
 
-    int intervalSeconds = g_config.gold.intervalMinutes * 60;
+    int intervalSeconds = config.gold.intervalMinutes * 60;
     if (elapsed >= intervalSeconds) {
-        auto* player = RE::PlayerCharacter::GetSingleton();
         auto* gold = RE::TESForm::LookupByID<RE::TESBoundObject>(0x0000000F);
 
-        if (player && gold) {
-            player->AddObjectToContainer(gold, nullptr, g_config.gold.amount, nullptr);
+        if (gold) {
+            g_effects.AddItem(gold, config.gold.amount);
 
-            if (g_config.notification.enabled && g_config.gold.showNotification) {
+            if (config.notification.enabled && config.gold.showNotification) {
                 std::string msg = "OSurvival - Incredible resistance rewarded with " +
-                                  std::to_string(g_config.gold.amount) + " gold";
-                RE::DebugNotification(msg.c_str());
+                                  std::to_string(config.gold.amount) + " gold";
+                g_effects.Notify(msg);
             }
 
-            WriteToActionsLog("Player received " + std::to_string(g_config.gold.amount) +
+            WriteToActionsLog("Player received " + std::to_string(config.gold.amount) +
                                   " gold (OStim scene: " + GetLastAnimation() + ")",
                               __LINE__);
         }
 
         g_lastGoldRewardTime = now;
-    }
-}
-
-void CheckAndRewardItem1() {
-    LoadConfiguration();
-
-    if (!g_config.item1.enabled || !IsInOStimScene() || GetLastAnimation().empty()) {
-        return;
-    }
-
-    auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - g_lastItem1RewardTime).count();
-
-    int intervalSeconds = g_config.item1.intervalMinutes * 60;
-    if (elapsed >= intervalSeconds) {
-        if (g_cachedItemFormIDs.item1 == 0) {
-            WriteToActionsLog("DEBUG: Item1 - Cached FormID is 0, skipping reward", __LINE__);
-            g_lastItem1RewardTime = now;
-            return;
-        }
-
-        auto* player = RE::PlayerCharacter::GetSingleton();
-        if (!player) {
-            WriteToActionsLog("DEBUG: Item1 - Player pointer is nullptr", __LINE__);
-            g_lastItem1RewardTime = now;
-            return;
-        }
-
-        auto* itemForm = RE::TESForm::LookupByID(g_cachedItemFormIDs.item1);
-        if (!itemForm) {
-            WriteToActionsLog("DEBUG: Item1 - TESForm::LookupByID returned nullptr for FormID: 0x" + 
-                std::to_string(g_cachedItemFormIDs.item1), __LINE__);
-            g_lastItem1RewardTime = now;
-            return;
-        }
-
-        auto* item = itemForm->As<RE::TESBoundObject>();
-        if (!item) {
-            WriteToActionsLog("DEBUG: Item1 - Form is not a TESBoundObject, FormType: " + 
-                std::to_string(static_cast<int>(itemForm->GetFormType())), __LINE__);
-            g_lastItem1RewardTime = now;
-            return;
-        }
-
-        player->AddObjectToContainer(item, nullptr, g_config.item1.amount, nullptr);
-
-        if (g_config.notification.enabled && g_config.item1.showNotification) {
-            std::string msg = "OSurvival - Received " + std::to_string(g_config.item1.amount) + " " + g_config.item1.itemName;
-            RE::DebugNotification(msg.c_str());
-        }
-
-        WriteToActionsLog("Player received " + std::to_string(g_config.item1.amount) +
-                              " " + g_config.item1.itemName + " (OStim scene: " + GetLastAnimation() + ")",
-                          __LINE__);
-
-        g_lastItem1RewardTime = now;
-    }
-}
-
-void CheckAndRewardItem2() {
-    LoadConfiguration();
-
-    if (!g_config.item2.enabled || !IsInOStimScene() || GetLastAnimation().empty()) {
-        return;
-    }
-
-    auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - g_lastItem2RewardTime).count();
-
-    int intervalSeconds = g_config.item2.intervalMinutes * 60;
-    if (elapsed >= intervalSeconds) {
-        if (g_cachedItemFormIDs.item2 == 0) {
-            WriteToActionsLog("DEBUG: Item2 - Cached FormID is 0, skipping reward", __LINE__);
-            g_lastItem2RewardTime = now;
-            return;
-        }
-
-        auto* player = RE::PlayerCharacter::GetSingleton();
-        if (!player) {
-            WriteToActionsLog("DEBUG: Item2 - Player pointer is nullptr", __LINE__);
-            g_lastItem2RewardTime = now;
-            return;
-        }
-
-        auto* itemForm = RE::TESForm::LookupByID(g_cachedItemFormIDs.item2);
-        if (!itemForm) {
-            WriteToActionsLog("DEBUG: Item2 - TESForm::LookupByID returned nullptr for FormID: 0x" + 
-                std::to_string(g_cachedItemFormIDs.item2), __LINE__);
-            g_lastItem2RewardTime = now;
-            return;
-        }
-
-        auto* item = itemForm->As<RE::TESBoundObject>();
-        if (!item) {
-            WriteToActionsLog("DEBUG: Item2 - Form is not a TESBoundObject, FormType: " + 
-                std::to_string(static_cast<int>(itemForm->GetFormType())), __LINE__);
-            g_lastItem2RewardTime = now;
-            return;
-        }
-
-        player->AddObjectToContainer(item, nullptr, g_config.item2.amount, nullptr);
-
-        if (g_config.notification.enabled && g_config.item2.showNotification) {
-            std::string msg = "OSurvival - Received " + std::to_string(g_config.item2.amount) + " " + g_config.item2.itemName;
-            RE::DebugNotification(msg.c_str());
-        }
-
-        WriteToActionsLog("Player received " + std::to_string(g_config.item2.amount) +
-                              " " + g_config.item2.itemName + " (OStim scene: " + GetLastAnimation() + ")",
-                          __LINE__);
-
-        g_lastItem2RewardTime = now;
-    }
-}
-
-void CheckAndRewardMilk() {
-    LoadConfiguration();
-
-    if (!g_config.milk.enabled || !IsInOStimScene() || GetLastAnimation().empty()) {
-        return;
-    }
-
-    auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - g_lastMilkRewardTime).count();
-
-    int intervalSeconds = g_config.milk.intervalMinutes * 60;
-    if (elapsed >= intervalSeconds) {
-        if (g_cachedItemFormIDs.milkDawnguard == 0) {
-            WriteToActionsLog("DEBUG: Milk (Dawnguard) - Cached FormID is 0, skipping reward", __LINE__);
-            g_lastMilkRewardTime = now;
-            return;
-        }
-
-        auto* player = RE::PlayerCharacter::GetSingleton();
-        if (!player) {
-            WriteToActionsLog("DEBUG: Milk (Dawnguard) - Player pointer is nullptr", __LINE__);
-            g_lastMilkRewardTime = now;
-            return;
-        }
-
-        auto* milkForm = RE::TESForm::LookupByID(g_cachedItemFormIDs.milkDawnguard);
-        if (!milkForm) {
-            WriteToActionsLog("DEBUG: Milk (Dawnguard) - TESForm::LookupByID returned nullptr for FormID: 0x" + 
-                std::to_string(g_cachedItemFormIDs.milkDawnguard), __LINE__);
-            g_lastMilkRewardTime = now;
-            return;
-        }
-
-        auto* milkItem = milkForm->As<RE::TESBoundObject>();
-        if (!milkItem) {
-            WriteToActionsLog("DEBUG: Milk (Dawnguard) - Form is not a TESBoundObject, FormType: " + 
-                std::to_string(static_cast<int>(milkForm->GetFormType())), __LINE__);
-            g_lastMilkRewardTime = now;
-            return;
-        }
-
-        player->AddObjectToContainer(milkItem, nullptr, g_config.milk.amount, nullptr);
-
-        if (g_config.notification.enabled && g_config.milk.showNotification) {
-            std::string msg = "OSurvival - Received " + std::to_string(g_config.milk.amount) + " Milk";
-            RE::DebugNotification(msg.c_str());
-        }
-
-        WriteToActionsLog("Player received " + std::to_string(g_config.milk.amount) +
-                              " Milk (OStim scene: " + GetLastAnimation() + ")",
-                          __LINE__);
-
-        g_lastMilkRewardTime = now;
-    }
-}
-
-void CheckAndRewardMilkWench() {
-    LoadConfiguration();
-
-    if (!g_config.milkWench.enabled || !IsInOStimScene() || GetLastAnimation().empty()) {
-        return;
-    }
-    
-    if (!g_wenchMilkNPCDetected) {
-        return;
-    }
-    
-    auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - g_lastMilkWenchRewardTime).count();
-    int intervalSeconds = g_config.milkWench.intervalMinutes * 60;
-    
-    if (elapsed >= intervalSeconds) {
-        if (g_cachedItemFormIDs.milkWench == 0) {
-            WriteToActionsLog("DEBUG: Wench Milk - Cached FormID is 0, skipping reward", __LINE__);
-            g_lastMilkWenchRewardTime = now;
-            return;
-        }
-        
-        auto* player = RE::PlayerCharacter::GetSingleton();
-        if (!player) {
-            WriteToActionsLog("DEBUG: Wench Milk - Player pointer is nullptr", __LINE__);
-            g_lastMilkWenchRewardTime = now;
-            return;
-        }
+    }
+}
 
-        auto* milkForm = RE::TESForm::LookupByID(g_cachedItemFormIDs.milkWench);
-        if (!milkForm) {
-            WriteToActionsLog("DEBUG: Wench Milk - TESForm::LookupByID returned nullptr for FormID: 0x" + 
-                std::to_string(g_cachedItemFormIDs.milkWench), __LINE__);
-            g_lastMilkWenchRewardTime = now;
-            return;
+void CheckAndRewardItems() {
+    const PluginConfig& config = g_config.Get();
+
+    if (!IsInOStimScene() || GetLastAnimation().empty()) {
+        return;
+    }
+
+    RefreshRewardTable();
+
+    auto holds = [](RewardCondition condition) {
+        switch (condition) {
+            case RewardCondition::kWenchNearby:
+                return g_wenchMilkNPCDetected;
+            case RewardCondition::kEthelNearby:
+                return g_ethelNPCDetected;
+            default:
+                return true;
         }
+    };
 
-        auto* milkItem = milkForm->As<RE::TESBoundObject>();
-        if (!milkItem) {
-            WriteToActionsLog("DEBUG: Wench Milk - Form is not a TESBoundObject, FormType: " + 
-                std::to_string(static_cast<int>(milkForm->GetFormType())), __LINE__);
-            g_lastMilkWenchRewardTime = now;
-            return;
+    g_rewardTable.IssueDue(std::chrono::steady_clock::now(), holds, [&](const auto& due) {
+        std::string received;
+        const std::string& animation = GetLastAnimation();
+        for (const auto* reward : due) {
+            g_effects.AddItem(reward->item, reward->amount);
+
+            std::string amount = std::to_string(reward->amount) + " " + reward->label;
+            if (reward->showNotification) {
+                received += (received.empty() ? "" : ", ") + amount;
+            }
+            WriteToActionsLog("Player received " + amount + " (OStim scene: " + animation + ")", __LINE__);
         }
-        
-        player->AddObjectToContainer(milkItem, nullptr, g_config.milkWench.amount, nullptr);
-        
-        if (g_config.notification.enabled && g_config.milkWench.showNotification) {
-            std::string msg = "OSurvival - Received " + std::to_string(g_config.milkWench.amount) + " Wench Milk";
-            RE::DebugNotification(msg.c_str());
+
+        if (config.notification.enabled && !received.empty()) {
+            std::string msg = "OSurvival - Received " + received;
+            g_effects.Notify(msg);
         }
-        
-        WriteToActionsLog("Player received " + std::to_string(g_config.milkWench.amount) +
-                          " Wench Milk with NPC nearby (OStim scene: " + GetLastAnimation() + ")",
-                          __LINE__);
-        
-        g_lastMilkWenchRewardTime = now;
-    }
+    });
 }
 
-void CheckAndRewardMilkEthel() {
-    LoadConfiguration();
+void QueueGlobalReduction(RE::TESGlobal* global, float amount) {
+    g_effects.ReduceGlobal(global, amount);
+}
 
-    if (!g_config.milkEthel.enabled || !IsInOStimScene() || GetLastAnimation().empty()) {
+// Hands everything queued since the last flush to the game thread as one task.
+void FlushEffects() {
+    auto batch = g_effects.Take();
+    if (batch.Empty()) {
         return;
     }
-    
-    if (!g_ethelNPCDetected) {
+
+    auto* tasks = SKSE::GetTaskInterface();
+    if (!tasks) {
         return;
     }
-    
-    auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - g_lastMilkEthelRewardTime).count();
-    int intervalSeconds = g_config.milkEthel.intervalMinutes * 60;
-    
-    if (elapsed >= intervalSeconds) {
-        if (g_cachedItemFormIDs.milkEthel == 0) {
-            WriteToActionsLog("DEBUG: Milk Ethel - Cached FormID is 0, skipping reward", __LINE__);
-            g_lastMilkEthelRewardTime = now;
-            return;
-        }
-        
-        auto* player = RE::PlayerCharacter::GetSingleton();
-        if (!player) {
-            WriteToActionsLog("DEBUG: Milk Ethel - Player pointer is nullptr", __LINE__);
-            g_lastMilkEthelRewardTime = now;
-            return;
-        }
 
-        auto* milkForm = RE::TESForm::LookupByID(g_cachedItemFormIDs.milkEthel);
-        if (!milkForm) {
-            WriteToActionsLog("DEBUG: Milk Ethel - TESForm::LookupByID returned nullptr for FormID: 0x" + 
-                std::to_string(g_cachedItemFormIDs.milkEthel), __LINE__);
-            g_lastMilkEthelRewardTime = now;
-            return;
-        }
+    tasks->AddTask([batch = std::move(batch)]() {
+        auto start = std::chrono::steady_clock::now();
 
-        auto* milkItem = milkForm->As<RE::TESBoundObject>();
-        if (!milkItem) {
-            WriteToActionsLog("DEBUG: Milk Ethel - Form is not a TESBoundObject, FormType: " + 
-                std::to_string(static_cast<int>(milkForm->GetFormType())), __LINE__);
-            g_lastMilkEthelRewardTime = now;
-            return;
+        auto* player = RE::PlayerCharacter::GetSingleton();
+        if (player) {
+            for (const auto& effect : batch.items) {
+                player->AddObjectToContainer(effect.item, nullptr, effect.count, nullptr);
+            }
+            if (auto* actorValueOwner = player->AsActorValueOwner()) {
+                for (const auto& effect : batch.restores) {
+                    actorValueOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kDamage, effect.actorValue,
+                                                       effect.amount);
+                }
+            }
         }
-        
-        player->AddObjectToContainer(milkItem, nullptr, g_config.milkEthel.amount, nullptr);
-        
-        if (g_config.notification.enabled && g_config.milkEthel.showNotification) {
-            std::string msg = "OSurvival - Received " + std::to_string(g_config.milkEthel.amount) + " Milk Ethel";
-            RE::DebugNotification(msg.c_str());
+        for (const auto& effect : batch.globals) {
+            effect.global->value = std::max(0.0f, effect.global->value - effect.amount);
         }
-        
-        WriteToActionsLog("Player received " + std::to_string(g_config.milkEthel.amount) +
-                          " Milk Ethel with Ethel nearby (OStim scene: " + GetLastAnimation() + ")",
+        for (const auto& text : batch.notifications) {
+            RE::DebugNotification(text.c_str());
+        }
+
+        g_effects.RecordFlush(batch.Size(), std::chrono::steady_clock::now() - start);
+    });
+}
+
+void ResolveNeedsProviders() {
+    auto lookup = [](std::string_view editorID) { return RE::TESForm::LookupByEditorID<RE::TESGlobal>(editorID); };
+
+    for (auto* provider : {&g_survivalNeeds, &g_frostfallNeeds}) {
+        bool resolved = provider->Resolve(lookup);
+        WriteToActionsLog(std::string(provider->Name()) + (resolved ? " need globals resolved" : " need globals not found"),
                           __LINE__);
-        
-        g_lastMilkEthelRewardTime = now;
     }
 }
 
 void CheckAndRestoreSurvivalStats() {
-    LoadConfiguration();
+    const PluginConfig& config = g_config.Get();
 
-    if (!g_config.survival.enabled || !IsInOStimScene() || GetLastAnimation().empty()) {
+    if (!config.survival.enabled || !IsInOStimScene() || GetLastAnimation().empty()) {
         return;
     }
 
     auto now = std::chrono::steady_clock::now();
     auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - g_lastSurvivalReductionTime).count();
 
-    if (elapsed < g_config.survival.intervalSeconds) {
+    if (elapsed < config.survival.intervalSeconds) {
         return;
     }
 
-    auto hungerGlobal = RE::TESForm::LookupByEditorID<RE::TESGlobal>("Survival_HungerNeedValue");
-    auto coldGlobal = RE::TESForm::LookupByEditorID<RE::TESGlobal>("Survival_ColdNeedValue");
-    auto exhaustionGlobal = RE::TESForm::LookupByEditorID<RE::TESGlobal>("Survival_ExhaustionNeedValue");
-
-    if (!hungerGlobal || !coldGlobal || !exhaustionGlobal) {
+    if (!g_survivalNeeds.IsResolved()) {
         return;
     }
 
-    float currentHunger = hungerGlobal->value;
-    float currentCold = coldGlobal->value;
-    float currentExhaustion = exhaustionGlobal->value;
+    NeedValues current = g_survivalNeeds.Read();
 
-    if (currentHunger <= 0.0f && currentCold <= 0.0f && currentExhaustion <= 0.0f) {
+    if (current.AllAtOrBelow(0.0f)) {
         if (!g_allStatsAtZero) {
-            if (g_config.notification.enabled && g_config.survival.showNotification) {
-                RE::DebugNotification("OSurvival - Full recovery achieved");
+            if (config.notification.enabled && config.survival.showNotification) {
+                g_effects.Notify("OSurvival - Full recovery achieved");
             }
             WriteToActionsLog("All survival stats at 0 - fully recovered", __LINE__);
             g_allStatsAtZero = true;
@@ -3042,9 +1813,7 @@ void CheckAndRestoreSurvivalStats() {
     }
 
     if (!g_survivalRestorationActive) {
-        if (currentHunger > g_config.survival.activationThreshold ||
-            currentCold > g_config.survival.activationThreshold ||
-            currentExhaustion > g_config.survival.activationThreshold) {
+        if (current.AnyAbove(static_cast<float>(config.survival.activationThreshold))) {
             g_survivalRestorationActive = true;
             WriteToActionsLog("Survival restoration system activated", __LINE__);
         } else {
@@ -3052,24 +1821,21 @@ void CheckAndRestoreSurvivalStats() {
         }
     }
 
-    float newHunger = std::max(0.0f, currentHunger - static_cast<float>(g_config.survival.reductionAmountHunger));
-    float newCold = std::max(0.0f, currentCold - static_cast<float>(g_config.survival.reductionAmountCold));
-    float newExhaustion =
-        std::max(0.0f, currentExhaustion - static_cast<float>(g_config.survival.reductionAmountExhaustion));
-
-    hungerGlobal->value = newHunger;
-    coldGlobal->value = newCold;
-    exhaustionGlobal->value = newExhaustion;
+    NeedValues reduced = g_survivalNeeds.Reduce(current,
+                                                {static_cast<float>(config.survival.reductionAmountHunger),
+                                                 static_cast<float>(config.survival.reductionAmountCold),
+                                                 static_cast<float>(config.survival.reductionAmountExhaustion)},
+                                                QueueGlobalReduction);
 
-    if (g_config.notification.enabled && g_config.survival.showNotification) {
-        RE::DebugNotification("OSurvival - You gain warmth with your partner and feel better");
+    if (config.notification.enabled && config.survival.showNotification) {
+        g_effects.Notify("OSurvival - You gain warmth with your partner and feel better");
     }
 
     std::stringstream logMsg;
     logMsg << "Survival stats reduced: "
-           << "Hunger " << currentHunger << "->" << newHunger << ", "
-           << "Cold " << currentCold << "->" << newCold << ", "
-           << "Exhaustion " << currentExhaustion << "->" << newExhaustion;
+           << "Hunger " << current.value[kHungerNeed] << "->" << reduced.value[kHungerNeed] << ", "
+           << "Cold " << current.value[kColdNeed] << "->" << reduced.value[kColdNeed] << ", "
+           << "Exhaustion " << current.value[kExhaustionNeed] << "->" << reduced.value[kExhaustionNeed];
 
     std::string logStr = logMsg.str();
     WriteToActionsLog(logStr, __LINE__);
@@ -3077,43 +1843,79 @@ void CheckAndRestoreSurvivalStats() {
     g_lastSurvivalReductionTime = now;
 }
 
-void CheckAndRestoreAttributes() {
-    LoadConfiguration();
+void CheckAndRestoreFrostfallExposure() {
+    const PluginConfig& config = g_config.Get();
 
-    if (!g_config.attributes.enabled || !IsInOStimScene() || GetLastAnimation().empty()) {
+    if (!config.frostfall.enabled || !IsInOStimScene() || GetLastAnimation().empty() ||
+        !g_frostfallNeeds.IsResolved()) {
         return;
     }
 
     auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - g_lastAttributesRestorationTime).count();
+    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - g_lastFrostfallReductionTime).count();
 
-    if (elapsed < g_config.attributes.intervalSeconds) {
+    if (elapsed < config.frostfall.intervalSeconds) {
         return;
     }
 
-    auto* player = RE::PlayerCharacter::GetSingleton();
-    if (!player) {
+    NeedValues current = g_frostfallNeeds.Read();
+
+    if (current.AllAtOrBelow(0.0f)) {
+        g_frostfallRestorationActive = false;
         return;
     }
 
-    auto* actorValueOwner = player->AsActorValueOwner();
-    if (actorValueOwner) {
-        float amount = static_cast<float>(g_config.attributes.restorationAmount);
-        actorValueOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kDamage, RE::ActorValue::kHealth, amount);
-        actorValueOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kDamage, RE::ActorValue::kMagicka, amount);
-        actorValueOwner->RestoreActorValue(RE::ACTOR_VALUE_MODIFIER::kDamage, RE::ActorValue::kStamina, amount);
-
-        if (g_config.notification.enabled && g_config.attributes.showNotification) {
-            std::string msg =
-                "OSurvival - Attributes restored " + std::to_string(g_config.attributes.restorationAmount) + " points";
-            RE::DebugNotification(msg.c_str());
+    if (!g_frostfallRestorationActive) {
+        if (!current.AnyAbove(static_cast<float>(config.frostfall.activationThreshold))) {
+            return;
         }
+        g_frostfallRestorationActive = true;
+        WriteToActionsLog("Frostfall exposure restoration activated", __LINE__);
+    }
 
-        WriteToActionsLog("Player received " + std::to_string(g_config.attributes.restorationAmount) +
-                              " points in all attributes (Health, Magicka, Stamina)",
-                          __LINE__);
+    NeedValues reduced = g_frostfallNeeds.Reduce(
+        current, {0.0f, static_cast<float>(config.frostfall.reductionAmountCold), 0.0f}, QueueGlobalReduction);
+
+    if (config.notification.enabled && config.frostfall.showNotification) {
+        g_effects.Notify("OSurvival - Your partner's warmth keeps the cold away");
+    }
+
+    std::stringstream logMsg;
+    logMsg << "Frostfall exposure reduced: " << current.value[kColdNeed] << "->" << reduced.value[kColdNeed];
+    WriteToActionsLog(logMsg.str(), __LINE__);
+
+    g_lastFrostfallReductionTime = now;
+}
+
+void CheckAndRestoreAttributes() {
+    const PluginConfig& config = g_config.Get();
+
+    if (!config.attributes.enabled || !IsInOStimScene() || GetLastAnimation().empty()) {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(now - g_lastAttributesRestorationTime).count();
+
+    if (elapsed < config.attributes.intervalSeconds) {
+        return;
     }
 
+    float amount = static_cast<float>(config.attributes.restorationAmount);
+    g_effects.RestoreActorValue(RE::ActorValue::kHealth, amount);
+    g_effects.RestoreActorValue(RE::ActorValue::kMagicka, amount);
+    g_effects.RestoreActorValue(RE::ActorValue::kStamina, amount);
+
+    if (config.notification.enabled && config.attributes.showNotification) {
+        std::string msg =
+            "OSurvival - Attributes restored " + std::to_string(config.attributes.restorationAmount) + " points";
+        g_effects.Notify(msg);
+    }
+
+    WriteToActionsLog("Player received " + std::to_string(config.attributes.restorationAmount) +
+                          " points in all attributes (Health, Magicka, Stamina)",
+                      __LINE__);
+
     g_lastAttributesRestorationTime = now;
 }
 
@@ -3179,7 +1981,11 @@ private:
         }
         
         if (!actorName.empty() && !gender.empty()) {
-            ProcessOrgasmEvent(actorName, gender, isPlayer);
+            if (g_climaxEvents.TryPush({actorName, gender, isPlayer})) {
+                g_monitorScheduler.Wake(g_logTaskId);
+            } else {
+                WriteToOStimEventsLog("Climax queue full - event dropped for " + actorName, __LINE__);
+            }
         }
     }
 };
@@ -3209,74 +2015,110 @@ public:
     }
 };
 
-bool DetectSceneEnd(const std::string& line) {
-    if (line.find("[Thread.cpp:634] closing thread") != std::string::npos) {
-        WriteToAnimationsLog("DETECTED: OStim thread closing", __LINE__);
-        return true;
-    }
-    if (line.find("[ThreadManager.cpp:174] trying to stop thread") != std::string::npos) {
-        WriteToAnimationsLog("DETECTED: OStim trying to stop thread", __LINE__);
-        return true;
-    }
-    return false;
-}
-
-std::string DetectAnimationChange(const std::string& line) {
-    std::string animationName;
+void ProcessAnimationChange(bool sceneStarted) {
+    const std::string& animationName = GetLastAnimation();
 
-    if (line.find("[info]") != std::string::npos &&
-        line.find("[Thread.cpp:195] thread 0 changed to node") != std::string::npos) {
-        size_t nodePos = line.find("changed to node ");
-        if (nodePos != std::string::npos) {
-            size_t startPos = nodePos + 16;
-            if (startPos < line.length()) {
-                animationName = line.substr(startPos);
+    if (sceneStarted) {
+        BuildNPCsCacheForScene();
+        
+        bool playerExists = false;
+        for (const auto& actor : g_sceneActors) {
+            if (actor.refID == 0x14) {
+                playerExists = true;
+                break;
             }
         }
-    } else if (line.find("[info]") != std::string::npos &&
-               line.find("[OStimMenu.h:48] UI_TransitionRequest") != std::string::npos) {
-        size_t lastOpenBrace = line.rfind('{');
-        size_t lastCloseBrace = line.rfind('}');
-        if (lastOpenBrace != std::string::npos && lastCloseBrace != std::string::npos &&
-            lastCloseBrace > lastOpenBrace) {
-            animationName = line.substr(lastOpenBrace + 1, lastCloseBrace - lastOpenBrace - 1);
+        
+        if (!playerExists) {
+            ActorInfo playerInfo = CapturePlayerInfo();
+            if (playerInfo.captured) {
+                g_sceneActors.push_back(playerInfo);
+                LogActorInfo(playerInfo, true);
+            }
+        }
+        
+        WriteToOStimEventsLog("========================================", __LINE__);
+        WriteToOStimEventsLog("SCENE START EVENT", __LINE__);
+        WriteToOStimEventsLog("New OStim scene started", __LINE__);
+        WriteToOStimEventsLog("Starting animation: " + animationName, __LINE__);
+        WriteToOStimEventsLog("========================================", __LINE__);
+        
+        g_lastOStimEventCheck = std::chrono::steady_clock::now();
+        
+        RefreshRewardTable();
+        g_rewardTable.Restart(std::chrono::steady_clock::now());
+        
+        g_lastGoldRewardTime = std::chrono::steady_clock::now();
+        g_goldRewardActive = true;
+        g_lastSurvivalReductionTime = std::chrono::steady_clock::now();
+        g_survivalRestorationActive = false;
+        g_allStatsAtZero = false;
+        g_lastAttributesRestorationTime = std::chrono::steady_clock::now();
+        g_attributesRestorationActive = true;
+        g_lastNPCDetectionCheck = std::chrono::steady_clock::now();
+        g_wenchMilkNPCDetected = false;
+        g_ethelNPCDetected = false;
+
+        g_lastFrostfallReductionTime = std::chrono::steady_clock::now();
+        g_frostfallRestorationActive = false;
+
+        if (g_survivalNeeds.IsResolved()) {
+            NeedValues needs = g_survivalNeeds.Read();
+            g_lastHungerValue = needs.value[kHungerNeed];
+            g_lastColdValue = needs.value[kColdNeed];
+            g_lastExhaustionValue = needs.value[kExhaustionNeed];
+
+            std::stringstream msg;
+            msg << "Initial survival stats - Hunger: " << g_lastHungerValue << ", Cold: " << g_lastColdValue
+                << ", Exhaustion: " << g_lastExhaustionValue;
+            std::string msgStr = msg.str();
+            WriteToActionsLog(msgStr, __LINE__);
         }
-    }
 
-    if (!animationName.empty()) {
-        animationName.erase(animationName.find_last_not_of(" \n\r\t") + 1);
+        WriteToActionsLog("OStim scene started - all reward systems activated", __LINE__);
     }
 
-    return animationName;
+    std::string formattedAnimation = "{" + animationName + "}";
+    WriteToAnimationsLog(formattedAnimation, __LINE__);
 }
 
-void ProcessNewLine(const std::string& line, const std::string& hashStr) {
-    if (line.find("[warning]") != std::string::npos) {
+// Scene stage, on the monitor thread.
+void ApplyOStimEvent(const OStimEvent& event, bool threadClosing) {
+    if (event.kind == OStimEventKind::kOrgasm) {
+        ProcessOrgasmLine(event);
         return;
     }
 
-    if (g_processedLines.find(hashStr) != g_processedLines.end()) {
+    if (event.kind == OStimEventKind::kVoiceSet) {
+        DetectNPCNameFromVoiceSet(event.actor);
         return;
     }
-    
-    ParseOStimEventFromLine(line);
 
-    if (DetectSceneEnd(line)) {
-        g_processedLines.insert(hashStr);
-        if (IsInOStimScene()) {
-            SetInOStimScene(false);
+    bool wasActive = g_scene.IsActive();
+    SceneStateMachine::Step step = g_scene.Apply(event);
+    if (step.started || step.ended || g_scene.IsActive() != wasActive) {
+        g_monitorScheduler.WakeAll();
+    }
+
+    if (step.speedChanged) {
+        ProcessSpeedChange();
+    }
+
+    if (event.kind == OStimEventKind::kSceneEnd) {
+        if (threadClosing) {
+            WriteToAnimationsLog("DETECTED: OStim thread closing", __LINE__);
+        } else {
+            WriteToAnimationsLog("DETECTED: OStim trying to stop thread", __LINE__);
+        }
+        if (step.ended) {
+            ClearNPCsCache();
             g_goldRewardActive = false;
-            g_item1RewardActive = false;
-            g_item2RewardActive = false;
-            g_milkRewardActive = false;
-            g_milkWenchRewardActive = false;
-            g_milkEthelRewardActive = false;
             g_survivalRestorationActive = false;
             g_allStatsAtZero = false;
+            g_frostfallRestorationActive = false;
             g_attributesRestorationActive = false;
             
-            g_detectedNPCNames.clear();
-            g_npcNameToRefID.clear();
+            ClearDetectedNPCs();
             g_sceneActors.clear();
             
             WriteToActionsLog("OStim scene ended - all reward systems stopped", __LINE__);
@@ -3285,248 +2127,272 @@ void ProcessNewLine(const std::string& line, const std::string& hashStr) {
         return;
     }
 
-    DetectNPCNamesFromLine(line);
-    
-    std::string animationName = DetectAnimationChange(line);
-    if (!animationName.empty()) {
-        g_processedLines.insert(hashStr);
+    if (step.animationChanged) {
+        ProcessAnimationChange(step.started);
+    }
 
-        if (animationName == GetLastAnimation()) {
-            return;
-        }
+    if (step.speedReset) {
+        ProcessNodeSpeedReset();
+    }
+}
 
-        SetLastAnimation(animationName);
+// Scene stage: takes over the scene that was running when OStim.log was last written, as
+// found at its end, and sets up the rewards for it once.
+void ApplyResumedScene(const OStimEventRecord& scene) {
+    bool wasActive = g_scene.IsActive();
+    SceneStateMachine::Step step = g_scene.Restore(scene.node, scene.speed);
+    if (step.started || g_scene.IsActive() != wasActive) {
+        g_monitorScheduler.WakeAll();
+    }
 
-        if (!IsInOStimScene()) {
-            BuildNPCsCacheForScene();
-            
-            SetInOStimScene(true);
-            
-            bool playerExists = false;
-            for (const auto& actor : g_sceneActors) {
-                if (actor.refID == 0x14) {
-                    playerExists = true;
-                    break;
-                }
-            }
-            
-            if (!playerExists) {
-                ActorInfo playerInfo = CapturePlayerInfo();
-                if (playerInfo.captured) {
-                    g_sceneActors.push_back(playerInfo);
-                    LogActorInfo(playerInfo, true);
-                }
-            }
-            
-            WriteToOStimEventsLog("========================================", __LINE__);
-            WriteToOStimEventsLog("SCENE START EVENT", __LINE__);
-            WriteToOStimEventsLog("New OStim scene started", __LINE__);
-            WriteToOStimEventsLog("Starting animation: " + animationName, __LINE__);
-            WriteToOStimEventsLog("========================================", __LINE__);
-            
-            g_currentOStimSpeed = 0;
-            g_lastOStimEventCheck = std::chrono::steady_clock::now();
-            
-            ResolveItemFormIDs();
-            
-            g_lastGoldRewardTime = std::chrono::steady_clock::now();
-            g_goldRewardActive = true;
-            g_lastItem1RewardTime = std::chrono::steady_clock::now();
-            g_item1RewardActive = true;
-            g_lastItem2RewardTime = std::chrono::steady_clock::now();
-            g_item2RewardActive = true;
-            g_lastMilkRewardTime = std::chrono::steady_clock::now();
-            g_milkRewardActive = true;
-            g_lastMilkWenchRewardTime = std::chrono::steady_clock::now();
-            g_milkWenchRewardActive = true;
-            g_lastMilkEthelRewardTime = std::chrono::steady_clock::now();
-            g_milkEthelRewardActive = true;
-            g_lastSurvivalReductionTime = std::chrono::steady_clock::now();
-            g_survivalRestorationActive = false;
-            g_allStatsAtZero = false;
-            g_lastAttributesRestorationTime = std::chrono::steady_clock::now();
-            g_attributesRestorationActive = true;
-            g_lastNPCDetectionCheck = std::chrono::steady_clock::now();
-            g_wenchMilkNPCDetected = false;
-            g_ethelNPCDetected = false;
+    WriteToAnimationsLog("Resumed OStim scene from the end of OStim.log: " + scene.node + " at speed " +
+                             std::to_string(scene.speed),
+                         __LINE__);
+    if (step.started || step.animationChanged) {
+        ProcessAnimationChange(step.started);
+    }
+}
 
-            auto hungerGlobal = RE::TESForm::LookupByEditorID<RE::TESGlobal>("Survival_HungerNeedValue");
-            auto coldGlobal = RE::TESForm::LookupByEditorID<RE::TESGlobal>("Survival_ColdNeedValue");
-            auto exhaustionGlobal = RE::TESForm::LookupByEditorID<RE::TESGlobal>("Survival_ExhaustionNeedValue");
+// One slice of OStim.log work for either stage, from [OStimLog] SliceLines and SliceMilliseconds.
+OStimLogTailer::ReadBudget GetLogSliceBudget() {
+    const PluginConfig& config = g_config.Get();
+    OStimLogTailer::ReadBudget budget;
+    budget.maxLines = static_cast<std::size_t>(std::max(config.ostimLog.sliceLines, 1));
+    budget.maxTime = std::chrono::milliseconds(std::max(config.ostimLog.sliceMilliseconds, 1));
+    return budget;
+}
 
-            if (hungerGlobal && coldGlobal && exhaustionGlobal) {
-                g_lastHungerValue = hungerGlobal->value;
-                g_lastColdValue = coldGlobal->value;
-                g_lastExhaustionValue = exhaustionGlobal->value;
+// Applies at most one slice of queued events, so a backlog does not hold up the checks due
+// behind this task. Returns whether more are waiting.
+bool ApplyQueuedEvents() {
+    OStimLogTailer::ReadBudget budget = GetLogSliceBudget();
+    auto deadline = std::chrono::steady_clock::now() + budget.maxTime;
+    std::size_t applied = 0;
 
-                std::stringstream msg;
-                msg << "Initial survival stats - Hunger: " << g_lastHungerValue << ", Cold: " << g_lastColdValue
-                    << ", Exhaustion: " << g_lastExhaustionValue;
-                std::string msgStr = msg.str();
-                WriteToActionsLog(msgStr, __LINE__);
+    try {
+        LogStageMessage message;
+        while (applied < budget.maxLines && std::chrono::steady_clock::now() < deadline &&
+               g_logEvents.TryPop(message)) {
+            applied++;
+            if (message.type == LogStageMessage::Type::kLogReset) {
+                if (g_scene.ClearAnimation()) {
+                    g_monitorScheduler.WakeAll();
+                }
+            } else if (message.type == LogStageMessage::Type::kResume) {
+                ApplyResumedScene(message.event);
+            } else {
+                ApplyOStimEvent(message.event.View(), message.threadClosing);
             }
-
-            WriteToActionsLog("OStim scene started - all reward systems activated", __LINE__);
         }
 
-        if (g_processedLines.size() > 500) {
-            g_processedLines.clear();
+        ClimaxMessage climax;
+        while (g_climaxEvents.TryPop(climax)) {
+            ProcessOrgasmEvent(climax.actorName, climax.gender, climax.isPlayer);
         }
-
-        std::string formattedAnimation = "{" + animationName + "}";
-        WriteToAnimationsLog(formattedAnimation, __LINE__);
+    } catch (const std::exception& e) {
+        logger::error("Error applying OStim events: {}", e.what());
+    } catch (...) {
+        logger::error("Unknown error applying OStim events");
     }
+    return g_logEvents.Size() > 0;
 }
 
-void ProcessOStimLog() {
-    try {
-        if (g_isShuttingDown.load()) {
-            return;
-        }
-
-        if (!g_initialDelayComplete) {
-            auto currentTime = std::chrono::steady_clock::now();
-            auto elapsedSeconds =
-                std::chrono::duration_cast<std::chrono::seconds>(currentTime - g_monitoringStartTime).count();
-            if (elapsedSeconds < 5) {
-                return;
-            } else {
-                g_initialDelayComplete = true;
-                WriteToAnimationsLog("5-second initial delay complete, starting dual-path OStim.log monitoring",
-                                     __LINE__);
-            }
+// Reader stage, on the file watch thread. Waits for the monitor thread rather than dropping an
+// event when it has fallen a whole queue behind.
+bool PublishLogMessage(LogStageMessage&& message) {
+    while (!g_logEvents.TryPush(std::move(message))) {
+        g_monitorScheduler.Wake(g_logTaskId);
+        if (!g_fileWatchActive || g_isShuttingDown.load()) {
+            return false;
         }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
 
-        std::vector<fs::path> ostimLogPaths = {g_ostimLogPaths.primary / "OStim.log",
-                                               g_ostimLogPaths.secondary / "OStim.log"};
+bool ReadOStimLogLine(std::string_view line) {
+    OStimLogLine parsed;
+    if (!g_lineFilter.Parse(line, parsed)) {
+        return false;
+    }
 
-        fs::path activeOStimLogPath;
-        bool foundLog = false;
+    LogStageMessage message;
+    message.event = OStimEventRecord(parsed.event);
+    message.threadClosing = parsed.threadClosing;
+    return PublishLogMessage(std::move(message));
+}
 
-        for (const auto& logPath : ostimLogPaths) {
-            if (fs::exists(logPath)) {
-                activeOStimLogPath = logPath;
-                foundLog = true;
+// Reads one slice of whatever OStim.log has gained; returns whether more is already waiting.
+bool ReadOStimLog() {
+    try {
+        bool reset = false;
+        switch (g_ostimLogTailer.Refresh()) {
+            case OStimLogTailer::Status::kMissing:
+            case OStimLogTailer::Status::kUnchanged:
+                g_logBacklogBytes = 0;
+                return false;
+            case OStimLogTailer::Status::kTruncated:
+                reset = true;
+                WriteToAnimationsLog("OStim.log reset detected - restarting monitoring", __LINE__);
+                break;
+            case OStimLogTailer::Status::kRotated:
+                reset = true;
+                WriteToAnimationsLog("OStim.log replaced - reopened " + g_ostimLogTailer.GetActivePath().string(),
+                                     __LINE__);
+                break;
+            default:
                 break;
-            }
-        }
-
-        if (!foundLog) {
-            return;
-        }
-
-        size_t currentFileSize = fs::file_size(activeOStimLogPath);
-        if (currentFileSize < g_lastFileSize) {
-            g_lastOStimLogPosition = 0;
-            g_processedLines.clear();
-            SetLastAnimation("");
-            WriteToAnimationsLog("OStim.log reset detected - restarting monitoring", __LINE__);
-        } else if (currentFileSize == g_lastFileSize && g_lastOStimLogPosition > 0) {
-            return;
-        }
-
-        g_lastFileSize = currentFileSize;
-
-        std::ifstream ostimLog(activeOStimLogPath, std::ios::in);
-        if (!ostimLog.is_open()) {
-            return;
         }
 
-        if (g_lastOStimLogPosition == 0) {
-            ostimLog.seekg(0, std::ios::beg);
-        } else {
-            ostimLog.seekg(g_lastOStimLogPosition);
+        std::size_t queued = 0;
+        if (reset) {
+            g_lineFilter.Clear();
+            LogStageMessage message;
+            message.type = LogStageMessage::Type::kLogReset;
+            queued += PublishLogMessage(std::move(message));
         }
 
-        std::string line;
-        while (std::getline(ostimLog, line)) {
-            size_t lineHash = std::hash<std::string>{}(line);
-            std::string hashStr = std::to_string(lineHash);
-            ProcessNewLine(line, hashStr);
-        }
+        g_ostimLogTailer.ReadLines([&](std::string_view view) {
+            queued += ReadOStimLogLine(view);
+        }, GetLogSliceBudget());
 
-        g_lastOStimLogPosition = ostimLog.tellg();
-        if (ostimLog.eof()) {
-            ostimLog.clear();
-            ostimLog.seekg(0, std::ios::end);
-            g_lastOStimLogPosition = ostimLog.tellg();
+        if (queued > 0) {
+            g_monitorScheduler.Wake(g_logTaskId);
         }
 
-        ostimLog.close();
+        g_logBacklogBytes = g_ostimLogTailer.GetBacklogBytes();
+        return g_ostimLogTailer.HasBacklog();
 
     } catch (const std::exception& e) {
         logger::error("Error processing OStim.log: {}", e.what());
     } catch (...) {
         logger::error("Unknown error processing OStim.log");
     }
+    return false;
 }
 
-void FileWatchThreadFunction() {
-    WriteToAnimationsLog("File watch thread started using Windows ReadDirectoryChangesW", __LINE__);
-
-    std::vector<fs::path> watchPaths = {g_ostimLogPaths.primary, g_ostimLogPaths.secondary};
+// Reader stage: starts at the end of OStim.log instead of replaying everything it already holds,
+// so getting ready after a load does not depend on how large the log has grown. The scene that
+// was running is rebuilt from at most ResumeScanKB of its last lines, read backward.
+void ResumeOStimLogAtTail() {
+    const PluginConfig& config = g_config.Get();
+    if (!config.ostimLog.resumeAtTail) {
+        return;
+    }
 
-    for (const auto& watchPath : watchPaths) {
-        if (!fs::exists(watchPath)) {
-            continue;
+    try {
+        if (g_ostimLogTailer.Refresh() == OStimLogTailer::Status::kMissing) {
+            return;
         }
 
-        HANDLE hDir = CreateFileW(watchPath.wstring().c_str(), FILE_LIST_DIRECTORY,
-                                  FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING,
-                                  FILE_FLAG_BACKUP_SEMANTICS, NULL);
-
-        if (hDir == INVALID_HANDLE_VALUE) {
-            continue;
+        auto start = std::chrono::steady_clock::now();
+        g_ostimLogTailer.SeekToEnd();
+        SceneResumeScan scan;
+        std::uint64_t scanBytes = static_cast<std::uint64_t>(std::max(config.ostimLog.resumeScanKB, 0)) * 1024;
+        g_ostimLogTailer.ReadLinesBackward(scanBytes, [&](std::string_view line) { return scan.Feed(line); });
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+        WriteToAnimationsLog(std::format("Resuming OStim.log at byte {} of {} after scanning {} lines back in {} us - {}",
+                                         g_ostimLogTailer.GetPosition(), g_ostimLogTailer.GetFileSize(), scan.Lines(),
+                                         elapsed.count(), scan.InScene() ? "scene in progress" : "no scene in progress"),
+                             __LINE__);
+
+        if (scan.InScene()) {
+            LogStageMessage message;
+            message.type = LogStageMessage::Type::kResume;
+            message.event.node = scan.Animation();
+            message.event.speed = scan.Speed();
+            if (PublishLogMessage(std::move(message))) {
+                g_monitorScheduler.Wake(g_logTaskId);
+            }
         }
+    } catch (const std::exception& e) {
+        logger::error("Error resuming OStim.log: {}", e.what());
+    } catch (...) {
+        logger::error("Unknown error resuming OStim.log");
+    }
+}
 
-        g_directoryHandle = hDir;
-
-        char buffer[4096];
-        DWORD bytesReturned;
-
-        while (g_fileWatchActive && !g_isShuttingDown.load()) {
-            BOOL result = ReadDirectoryChangesW(
-                hDir, buffer, sizeof(buffer), FALSE,
-                FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_FILE_NAME, &bytesReturned,
-                NULL, NULL);
-
-            if (!result) {
-                break;
-            }
+void FileWatchThreadFunction() {
+    // Both SKSE log folders are watched at once; a burst of writes to OStim.log is read once
+    // per coalesce window. The log is also re-read on a timer, every second when its folder
+    // could not be watched.
+    if (g_logWatcher.Start({g_ostimLogPaths.primary, g_ostimLogPaths.secondary}, L"OStim.log")) {
+        WriteToAnimationsLog("File watch thread started using overlapped ReadDirectoryChangesW", __LINE__);
+    } else {
+        WriteToAnimationsLog("File watch could not open either SKSE log folder - polling OStim.log", __LINE__);
+    }
+    WriteToAnimationsLog("Waiting 5 seconds before starting OStim.log analysis", __LINE__);
 
-            if (bytesReturned == 0) {
+    using std::chrono::milliseconds;
+    using std::chrono::seconds;
+    using std::chrono::steady_clock;
+
+    auto readFrom = steady_clock::now() + seconds(5);
+    bool delayComplete = false;
+
+    // A backlog is read one slice per pass, straight after another without waiting, so a stop
+    // request is seen between slices.
+    std::uint64_t backlogSlices = 0;
+    std::uint64_t backlogPeakBytes = 0;
+    steady_clock::time_point backlogSince;
+
+    while (g_fileWatchActive && !g_isShuttingDown.load()) {
+        auto now = steady_clock::now();
+        milliseconds timeout = IsActiveLogWatched() ? seconds(5) : seconds(1);
+        if (!delayComplete && now >= readFrom) {
+            delayComplete = true;
+            WriteToAnimationsLog("5-second initial delay complete, starting dual-path OStim.log monitoring", __LINE__);
+            ResumeOStimLogAtTail();
+        }
+        if (delayComplete) {
+            bool behind = ReadOStimLog();
+            std::uint64_t backlogBytes = g_logBacklogBytes.load();
+            if (behind) {
+                if (backlogSlices++ == 0) {
+                    backlogSince = now;
+                    WriteToAnimationsLog(std::format("OStim.log backlog of {} KB - reading it in slices",
+                                                     backlogBytes / 1024),
+                                         __LINE__);
+                }
+                backlogPeakBytes = std::max(backlogPeakBytes, backlogBytes);
                 continue;
             }
-
-            FILE_NOTIFY_INFORMATION* pNotify = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(buffer);
-
-            do {
-                std::wstring filename(pNotify->FileName, pNotify->FileNameLength / sizeof(wchar_t));
-                if (filename == L"OStim.log") {
-                    ProcessOStimLog();
-                }
-
-                if (pNotify->NextEntryOffset == 0) {
-                    break;
-                }
-                pNotify = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(reinterpret_cast<BYTE*>(pNotify) +
-                                                                      pNotify->NextEntryOffset);
-            } while (true);
+            if (backlogSlices > 0) {
+                auto took = std::chrono::duration_cast<milliseconds>(steady_clock::now() - backlogSince);
+                WriteToAnimationsLog(std::format("OStim.log backlog cleared after {} slices in {} ms, peak {} KB",
+                                                 backlogSlices + 1, took.count(), backlogPeakBytes / 1024),
+                                     __LINE__);
+                backlogSlices = 0;
+                backlogPeakBytes = 0;
+            }
+        } else {
+            timeout = std::min(timeout, std::chrono::ceil<milliseconds>(readFrom - now));
         }
 
-        CloseHandle(hDir);
-        g_directoryHandle = INVALID_HANDLE_VALUE;
-
-        if (g_fileWatchActive && !g_isShuttingDown.load()) {
-            continue;
-        } else {
+        DirectoryWatcher::Result result = g_logWatcher.Wait(timeout);
+        if (result == DirectoryWatcher::Result::kStopped) {
             break;
         }
+        if (result == DirectoryWatcher::Result::kError) {
+            // Without its watches the watcher still waits out the timeout and honours Stop(),
+            // so OStim.log keeps being read on the 1 s poll.
+            g_logWatcher.Close();
+            WriteToAnimationsLog("File watch failed - polling OStim.log", __LINE__);
+        }
     }
+
+    DirectoryWatcher::Stats stats = g_logWatcher.GetStats();
+    g_logWatcher.Close();
+    WriteToAnimationsLog(std::format("File watch stopped: {} signals from {} notification records, {} overflows",
+                                     stats.signals, stats.records, stats.overflows),
+                         __LINE__);
 }
 
 void StartFileWatch() {
     if (!g_fileWatchActive) {
+        g_ostimLogTailer.SetCandidates({g_ostimLogPaths.primary / "OStim.log", g_ostimLogPaths.secondary / "OStim.log"});
+        g_lineFilter.Clear();
         g_fileWatchActive = true;
         g_fileWatchThread = std::thread(FileWatchThreadFunction);
         WriteToAnimationsLog("File watch system activated", __LINE__);
@@ -3536,62 +2402,127 @@ void StartFileWatch() {
 void StopFileWatch() {
     if (g_fileWatchActive) {
         g_fileWatchActive = false;
-        if (g_directoryHandle != INVALID_HANDLE_VALUE) {
-            CloseHandle(g_directoryHandle);
-            g_directoryHandle = INVALID_HANDLE_VALUE;
-        }
+        g_logWatcher.Stop();
         if (g_fileWatchThread.joinable()) {
             g_fileWatchThread.join();
         }
     }
 }
 
+bool IsActiveLogWatched() {
+    if (!g_fileWatchActive) {
+        return false;
+    }
+
+    return g_logWatcher.IsWatching(g_ostimLogTailer.GetActivePath().parent_path());
+}
+
+// Outside a scene the periodic checks are parked; entering one wakes them. A check that
+// returned without acting (and so without moving its due time) retries a second later.
+DeadlineScheduler::TimePoint SceneTaskDeadline(bool enabled, DeadlineScheduler::TimePoint due,
+                                               DeadlineScheduler::TimePoint now) {
+    if (!enabled || !g_scene.IsActive()) {
+        return DeadlineScheduler::kNever;
+    }
+    return std::max(due, now + std::chrono::seconds(1));
+}
+
 void MonitoringThreadFunction() {
     WriteToAnimationsLog("Monitoring thread started - Watching OStim.log for animations", __LINE__);
     WriteToAnimationsLog("Monitoring OStim.log on dual paths (Primary & Secondary)", __LINE__);
     WriteToAnimationsLog("Primary: " + g_ostimLogPaths.primary.string(), __LINE__);
     WriteToAnimationsLog("Secondary: " + g_ostimLogPaths.secondary.string(), __LINE__);
-    WriteToAnimationsLog("Waiting 5 seconds before starting OStim.log analysis", __LINE__);
 
     g_monitoringStartTime = std::chrono::steady_clock::now();
-    g_initialDelayComplete = false;
 
-    while (g_monitoringActive && !g_isShuttingDown.load()) {
-        g_monitorCycles++;
-        ProcessOStimLog();
+    using std::chrono::seconds;
+
+    // Woken by the file watch thread whenever it has queued events. A backlog is applied a slice
+    // per run; the task is then due again at once, but after every check that fell due meanwhile.
+    g_logTaskId = g_monitorScheduler.Add("OStim.log events", [](DeadlineScheduler::TimePoint) {
+        return ApplyQueuedEvents() ? DeadlineScheduler::Clock::now() : DeadlineScheduler::kNever;
+    }, g_monitoringStartTime);
+
+    g_monitorScheduler.Add("configuration", [](DeadlineScheduler::TimePoint now) {
+        LoadConfiguration();
+        LoadClimaxConfiguration();
+        return now + (IsInOStimScene() ? seconds(2) : seconds(10));
+    }, g_monitoringStartTime);
+
+    g_monitorScheduler.Add("scene NPC RefIDs", [](DeadlineScheduler::TimePoint now) {
         FindAndCacheNPCRefIDs();
+        return IsInOStimScene() ? now + seconds(1) : DeadlineScheduler::kNever;
+    }, g_monitoringStartTime);
+
+    g_monitorScheduler.Add("nearby NPCs", [](DeadlineScheduler::TimePoint now) {
         CheckForNearbyNPCs();
+        return IsInOStimScene() ? std::max(g_lastNPCDetectionCheck + seconds(2), now + seconds(1))
+                                : DeadlineScheduler::kNever;
+    }, g_monitoringStartTime);
+
+    g_monitorScheduler.Add("status", [](DeadlineScheduler::TimePoint now) {
         ProcessOStimEventData();
+        return IsInOStimScene() ? std::max(g_lastOStimEventCheck + seconds(5), now + seconds(1))
+                                : DeadlineScheduler::kNever;
+    }, g_monitoringStartTime);
+
+    g_monitorScheduler.Add("gold", [](DeadlineScheduler::TimePoint now) {
         CheckAndRewardGold();
-        CheckAndRewardItem1();
-        CheckAndRewardItem2();
-        CheckAndRewardMilk();
-        CheckAndRewardMilkWench();
-        CheckAndRewardMilkEthel();
+        const PluginConfig& config = g_config.Get();
+        return SceneTaskDeadline(config.gold.enabled, g_lastGoldRewardTime + seconds(config.gold.intervalMinutes * 60), now);
+    }, g_monitoringStartTime);
+
+    g_monitorScheduler.Add("item rewards", [](DeadlineScheduler::TimePoint now) {
+        CheckAndRewardItems();
+        return SceneTaskDeadline(!g_rewardTable.Empty(), g_rewardTable.NextDue(), now);
+    }, g_monitoringStartTime);
+
+    g_monitorScheduler.Add("survival", [](DeadlineScheduler::TimePoint now) {
         CheckAndRestoreSurvivalStats();
+        const PluginConfig& config = g_config.Get();
+        return SceneTaskDeadline(config.survival.enabled, g_lastSurvivalReductionTime + seconds(config.survival.intervalSeconds), now);
+    }, g_monitoringStartTime);
+
+    g_monitorScheduler.Add("frostfall", [](DeadlineScheduler::TimePoint now) {
+        CheckAndRestoreFrostfallExposure();
+        const PluginConfig& config = g_config.Get();
+        return SceneTaskDeadline(config.frostfall.enabled, g_lastFrostfallReductionTime + seconds(config.frostfall.intervalSeconds), now);
+    }, g_monitoringStartTime);
+
+    g_monitorScheduler.Add("attributes", [](DeadlineScheduler::TimePoint now) {
         CheckAndRestoreAttributes();
-        std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+        const PluginConfig& config = g_config.Get();
+        return SceneTaskDeadline(config.attributes.enabled, g_lastAttributesRestorationTime + seconds(config.attributes.intervalSeconds), now);
+    }, g_monitoringStartTime);
+
+    g_monitorScheduler.SetIdleHook(FlushEffects);
+    g_monitorScheduler.Run();
+    FlushEffects();
+
+    WriteToAnimationsLog("Monitoring thread stopped after " + std::to_string(g_monitorScheduler.Runs()) +
+                             " task runs and " + std::to_string(g_monitorScheduler.Wakeups()) + " wakeups",
+                         __LINE__);
+
+    auto effects = g_effects.GetStats();
+    if (effects.flushes > 0) {
+        auto micros = [](std::chrono::nanoseconds ns) { return std::to_string(ns.count() / 1000); };
+        WriteToActionsLog("Effect flushes: " + std::to_string(effects.flushes) + " batches, " +
+                              std::to_string(effects.effects) + " effects, " +
+                              micros(effects.total / effects.flushes) + " us average, " + micros(effects.longest) +
+                              " us longest",
+                          __LINE__);
     }
 }
 
 void StartMonitoringThread() {
     if (!g_monitoringActive) {
         g_monitoringActive = true;
-        g_monitorCycles = 0;
-        g_lastOStimLogPosition = 0;
-        g_lastFileSize = 0;
-        g_processedLines.clear();
-        SetLastAnimation("");
-        g_initialDelayComplete = false;
-        SetInOStimScene(false);
+        g_monitorScheduler.Reset();
+        ResetSceneState();
         g_goldRewardActive = false;
-        g_item1RewardActive = false;
-        g_item2RewardActive = false;
-        g_milkRewardActive = false;
-        g_milkWenchRewardActive = false;
-        g_milkEthelRewardActive = false;
         g_survivalRestorationActive = false;
         g_allStatsAtZero = false;
+        g_frostfallRestorationActive = false;
         g_attributesRestorationActive = false;
         g_wenchMilkNPCDetected = false;
         g_ethelNPCDetected = false;
@@ -3599,17 +2530,12 @@ void StartMonitoringThread() {
         g_capturedYurianaWenchNPC.formID = 0;
         g_capturedEthelNPC.captured = false;
         g_capturedEthelNPC.formID = 0;
-        g_cachedItemFormIDs.resolved = false;
-        g_cachedItemFormIDs.item1 = 0;
-        g_cachedItemFormIDs.item2 = 0;
-        g_cachedItemFormIDs.milkDawnguard = 0;
-        g_cachedItemFormIDs.milkWench = 0;
-        g_cachedItemFormIDs.milkEthel = 0;
+        g_rewardTable.Clear();
+        g_rewardTableSource = nullptr;
         g_lastHungerValue = 0.0f;
         g_lastColdValue = 0.0f;
         g_lastExhaustionValue = 0.0f;
-        g_detectedNPCNames.clear();
-        g_npcNameToRefID.clear();
+        ClearDetectedNPCs();
         g_sceneActors.clear();
         g_monitorThread = std::thread(MonitoringThreadFunction);
 
@@ -3620,6 +2546,7 @@ void StartMonitoringThread() {
 void StopMonitoringThread() {
     if (g_monitoringActive) {
         g_monitoringActive = false;
+        g_monitorScheduler.Stop();
         if (g_monitorThread.joinable()) {
             g_monitorThread.join();
         }
@@ -3654,20 +2581,10 @@ void InitializePlugin() {
             g_gamePath = "C:\\Program Files (x86)\\Steam\\steamapps\\common\\Skyrim Special Edition";
         }
 
+        StartPluginLogs();
+
         auto logsFolder = SKSE::log::log_directory();
         if (logsFolder) {
-            auto actionsLogPath = *logsFolder / "OSurvival-Mode-NG-Actions.log";
-            std::ofstream clearActions(actionsLogPath, std::ios::trunc);
-            clearActions.close();
-
-            auto animationsLogPath = *logsFolder / "OSurvival-Mode-NG-Animations.log";
-            std::ofstream clearAnimations(animationsLogPath, std::ios::trunc);
-            clearAnimations.close();
-
-            auto eventsLogPath = *logsFolder / "OSurvival-Mode-NG-OStimEvents.log";
-            std::ofstream clearEvents(eventsLogPath, std::ios::trunc);
-            clearEvents.close();
-
             std::vector<fs::path> ostimLogPaths = {g_ostimLogPaths.primary / "OStim.log",
                                                    g_ostimLogPaths.secondary / "OStim.log"};
 
@@ -3702,13 +2619,13 @@ void InitializePlugin() {
         WriteToActionsLog("========================================", __LINE__);
         WriteToActionsLog("Monitoring game events: Menu + Gold + Item1 + Item2 + Milk (Dawnguard) + Wench Milk + Milk Ethel + NPC Detection + NPC Auto-Capture + Item Auto-Resolution + Survival + Attributes", __LINE__);
         WriteToActionsLog("Configuration loaded from INI file", __LINE__);
-        WriteToActionsLog("INI values are reloaded before each event execution", __LINE__);
+        WriteToActionsLog("INI changes are picked up automatically (checked once per monitoring cycle)", __LINE__);
         WriteToActionsLog("NPC detection system active (500 unit radius, only during OStim scenes)", __LINE__);
         WriteToActionsLog("NPC auto-capture system enabled for dynamic FormID resolution", __LINE__);
         WriteToActionsLog("Item auto-resolution system enabled for accurate FormID detection", __LINE__);
         WriteToActionsLog("Auto-disable missing plugins system enabled", __LINE__);
         WriteToActionsLog("Debug logging enabled for FormID validation", __LINE__);
-        WriteToActionsLog("Item1 and Item2 custom item reward systems enabled", __LINE__);
+        WriteToActionsLog("Item rewards: Item1, Item2, Milk, Wench Milk, Milk Ethel and any [Reward.*] sections", __LINE__);
         WriteToActionsLog("Vampire and Werewolf detection enabled", __LINE__);
         WriteToActionsLog("", __LINE__);
 
@@ -3766,6 +2683,8 @@ void ShutdownPlugin() {
     WriteToOStimEventsLog("========================================", __LINE__);
     WriteToOStimEventsLog("Plugin shutdown complete at: " + GetCurrentTimeString(), __LINE__);
     WriteToOStimEventsLog("========================================", __LINE__);
+
+    AsyncLogSink::GetSingleton().Stop();
 }
 
 void MessageListener(SKSE::MessagingInterface::Message* message) {
@@ -3773,20 +2692,16 @@ void MessageListener(SKSE::MessagingInterface::Message* message) {
         case SKSE::MessagingInterface::kNewGame:
             StopFileWatch();
             StopMonitoringThread();
-            g_lastOStimLogPosition = 0;
-            g_lastFileSize = 0;
-            g_processedLines.clear();
-            SetLastAnimation("");
-            g_initialDelayComplete = false;
-            SetInOStimScene(false);
+            g_effects.Clear();
+            g_ostimLogTailer.Reset();
+            g_lineFilter.Clear();
+            g_logEvents.Clear();
+            g_climaxEvents.Clear();
+            ResetSceneState();
             g_goldRewardActive = false;
-            g_item1RewardActive = false;
-            g_item2RewardActive = false;
-            g_milkRewardActive = false;
-            g_milkWenchRewardActive = false;
-            g_milkEthelRewardActive = false;
             g_survivalRestorationActive = false;
             g_allStatsAtZero = false;
+            g_frostfallRestorationActive = false;
             g_attributesRestorationActive = false;
             g_wenchMilkNPCDetected = false;
             g_ethelNPCDetected = false;
@@ -3794,17 +2709,12 @@ void MessageListener(SKSE::MessagingInterface::Message* message) {
             g_capturedYurianaWenchNPC.formID = 0;
             g_capturedEthelNPC.captured = false;
             g_capturedEthelNPC.formID = 0;
-            g_cachedItemFormIDs.resolved = false;
-            g_cachedItemFormIDs.item1 = 0;
-            g_cachedItemFormIDs.item2 = 0;
-            g_cachedItemFormIDs.milkDawnguard = 0;
-            g_cachedItemFormIDs.milkWench = 0;
-            g_cachedItemFormIDs.milkEthel = 0;
+            g_rewardTable.Clear();
+            g_rewardTableSource = nullptr;
             g_lastHungerValue = 0.0f;
             g_lastColdValue = 0.0f;
             g_lastExhaustionValue = 0.0f;
-            g_detectedNPCNames.clear();
-            g_npcNameToRefID.clear();
+            ClearDetectedNPCs();
             g_sceneActors.clear();
             InitializePlugin();
             break;
@@ -3825,6 +2735,9 @@ void MessageListener(SKSE::MessagingInterface::Message* message) {
                 WriteToAnimationsLog("Game event processor registered", __LINE__);
                 WriteToActionsLog("Event monitoring system active", __LINE__);
                 
+                BuildPluginIndexTable();
+                ResolveNeedsProviders();
+                ResolveCreatureForms();
                 ValidateAndUpdatePluginsInINI();
             }
             break;
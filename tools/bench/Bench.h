@@ -0,0 +1,42 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+
+// Minimal timing helpers shared by the osurvival_bench subcommands.
+
+inline const void* volatile g_benchSink = nullptr;
+
+// Publishes a result so the optimizer cannot drop the work that produced it.
+template <class T>
+inline void KeepAlive(const T& value) {
+    g_benchSink = &value;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+template <class Fn>
+inline double MeasureNsPerOp(std::size_t iterations, Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; i++) {
+        fn(i);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations);
+}
+
+inline void PrintBenchResult(std::string_view name, std::size_t iterations, double nsPerOp) {
+    std::printf("%-44.*s %12zu iters %10.1f ns/op\n", static_cast<int>(name.size()), name.data(), iterations,
+                nsPerOp);
+}
+
+inline std::size_t ParseIterations(int argc, char** argv, std::size_t fallback) {
+    if (argc < 1) {
+        return fallback;
+    }
+    long long value = std::atoll(argv[0]);
+    return value > 0 ? static_cast<std::size_t>(value) : fallback;
+}
@@ -0,0 +1,53 @@
+#include <cstdio>
+#include <string_view>
+
+int RunTimestampBench(int argc, char** argv);
+int RunProximityBench(int argc, char** argv);
+int RunSchedulerBench(int argc, char** argv);
+int RunWatcherBench(int argc, char** argv);
+int RunOStimLogBench(int argc, char** argv);
+
+namespace {
+    struct BenchCommand {
+        std::string_view name;
+        int (*run)(int argc, char** argv);
+        std::string_view description;
+    };
+
+    constexpr BenchCommand kCommands[] = {
+        {"timestamp", RunTimestampBench, "[iterations]  cached log timestamps vs stringstream/put_time"},
+        {"proximity", RunProximityBench, "[iterations]  band classification at 10/100/1000 actors vs per-radius sqrt walks"},
+        {"scheduler", RunSchedulerBench, "[iterations]  monitor deadline scheduler: idle wakeups, Wake() latency, sub-second task"},
+        {"watcher", RunWatcherBench, "[bursts]      OStim.log directory watcher: notification records vs coalesced signals"},
+        {"ostimlog", RunOStimLogBench, "[max size]    generated OStim.log at 64K..max (default 256M): tailer, parser, dedup, resume, slices"},
+    };
+
+    int PrintUsage() {
+        std::printf("usage: osurvival_bench <command|all> [args]\n");
+        for (const auto& command : kCommands) {
+            std::printf("  %-12.*s %.*s\n", static_cast<int>(command.name.size()), command.name.data(),
+                        static_cast<int>(command.description.size()), command.description.data());
+        }
+        return 1;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        return PrintUsage();
+    }
+
+    std::string_view name = argv[1];
+    bool all = name == "all";
+    int result = 0;
+    bool ran = false;
+
+    for (const auto& command : kCommands) {
+        if (all || command.name == name) {
+            result |= command.run(argc - 2, argv + 2);
+            ran = true;
+        }
+    }
+
+    return ran ? result : PrintUsage();
+}
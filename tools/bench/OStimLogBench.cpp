@@ -0,0 +1,239 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <unistd.h>
+
+#include "core/OStimEventParser.h"
+#include "core/OStimLogTailer.h"
+#include "core/RecentLineSet.h"
+#include "core/SceneStateMachine.h"
+#include "tools/bench/Bench.h"
+#include "tools/loggen/OStimLogGenerator.h"
+
+namespace {
+    namespace fs = std::filesystem;
+    using Clock = std::chrono::steady_clock;
+
+    constexpr std::uint64_t kSizeClasses[] = {64ull << 10, 1ull << 20, 16ull << 20, 256ull << 20, 1ull << 30,
+                                              4ull << 30};
+    constexpr std::size_t kBatchLines = 64 * 1024;
+
+    std::string SizeLabel(std::uint64_t bytes) {
+        if (bytes >= (1ull << 30)) {
+            return std::to_string(bytes >> 30) + "G";
+        }
+        if (bytes >= (1ull << 20)) {
+            return std::to_string(bytes >> 20) + "M";
+        }
+        return std::to_string(bytes >> 10) + "K";
+    }
+
+    double Seconds(Clock::duration duration) { return std::chrono::duration<double>(duration).count(); }
+
+    double NsPerLine(Clock::duration duration, std::uint64_t lines) {
+        return lines ? std::chrono::duration<double, std::nano>(duration).count() / static_cast<double>(lines) : 0.0;
+    }
+
+    // Reads a generated file through the tailer in batches and times the three reader-side
+    // pieces separately: the tailer's read and line split, classify + parse, and the
+    // RecentLineSet dedup the line filter puts in front of scene-end and node events.
+    struct SizeClassRun {
+        std::uint64_t lines = 0;
+        std::uint64_t events = 0;
+        std::uint64_t suppressed = 0;
+        Clock::duration total{};
+        Clock::duration parse{};
+        Clock::duration dedup{};
+
+        std::string arena;
+        std::vector<std::uint32_t> lengths;
+        std::vector<std::pair<std::string_view, OStimEvent>> parsed;
+        RecentLineSet<512> seen;
+
+        void Flush() {
+            auto start = Clock::now();
+            std::size_t offset = 0;
+            for (std::uint32_t length : lengths) {
+                std::string_view line(arena.data() + offset, length);
+                offset += length;
+                OStimEvent event = ParseOStimEvent(line);
+                if (event.kind != OStimEventKind::kNone) {
+                    parsed.push_back({line, event});
+                }
+            }
+            auto parsedAt = Clock::now();
+            parse += parsedAt - start;
+
+            for (const auto& [line, event] : parsed) {
+                std::uint64_t hash = std::hash<std::string_view>{}(line);
+                if (seen.Contains(hash)) {
+                    suppressed++;
+                    continue;
+                }
+                if (event.kind == OStimEventKind::kSceneEnd ||
+                    (event.kind == OStimEventKind::kNodeChange && !event.node.empty())) {
+                    seen.Insert(hash);
+                }
+            }
+            dedup += Clock::now() - parsedAt;
+
+            lines += lengths.size();
+            events += parsed.size();
+            arena.clear();
+            lengths.clear();
+            parsed.clear();
+        }
+
+        bool Run(const fs::path& path) {
+            OStimLogTailer tailer;
+            tailer.SetCandidates({path});
+            if (tailer.Refresh() == OStimLogTailer::Status::kMissing) {
+                return false;
+            }
+
+            auto start = Clock::now();
+            tailer.ReadLines([this](std::string_view line) {
+                arena.append(line);
+                lengths.push_back(static_cast<std::uint32_t>(line.size()));
+                if (lengths.size() == kBatchLines) {
+                    Flush();
+                }
+            });
+            Flush();
+            total = Clock::now() - start;
+            return true;
+        }
+    };
+
+    // What the plugin does on load: jump to the end and rebuild the running scene from at most
+    // kResumeScanBytes of the last lines.
+    constexpr std::uint64_t kResumeScanBytes = 1024 * 1024;
+
+    Clock::duration MeasureResume(const fs::path& path, SceneResumeScan& scan) {
+        auto start = Clock::now();
+        OStimLogTailer tailer;
+        tailer.SetCandidates({path});
+        tailer.Refresh();
+        tailer.SeekToEnd();
+        tailer.ReadLinesBackward(kResumeScanBytes, [&scan](std::string_view line) { return scan.Feed(line); });
+        return Clock::now() - start;
+    }
+
+    // The plugin's default slice: what one pass of the reader may take before it checks for a
+    // stop and the monitor gets a turn.
+    constexpr std::size_t kSliceLines = 2000;
+    constexpr std::chrono::milliseconds kSliceTime{5};
+
+    struct SliceRun {
+        std::uint64_t slices = 0;
+        std::uint64_t events = 0;
+        Clock::duration longest{};
+    };
+
+    // Reads and parses the whole file a budgeted slice at a time, as the file watch thread does
+    // with a backlog.
+    SliceRun MeasureSlices(const fs::path& path) {
+        SliceRun run;
+        OStimLogTailer tailer;
+        tailer.SetCandidates({path});
+        OStimLogTailer::ReadBudget budget;
+        budget.maxLines = kSliceLines;
+        budget.maxTime = kSliceTime;
+
+        while (tailer.Refresh() == OStimLogTailer::Status::kAppended) {
+            auto start = Clock::now();
+            tailer.ReadLines([&run](std::string_view line) {
+                run.events += ParseOStimEvent(line).kind != OStimEventKind::kNone;
+            }, budget);
+            run.longest = std::max(run.longest, Clock::now() - start);
+            run.slices++;
+        }
+        return run;
+    }
+
+    bool ReportSizeClass(const fs::path& directory, std::uint64_t bytes) {
+        std::string label = SizeLabel(bytes);
+        fs::path path = directory / ("OStim_" + label + ".log");
+
+        OStimLogProfile profile;
+        profile.targetBytes = bytes;
+        OStimLogGenerator generator(profile);
+        auto generateStart = Clock::now();
+        if (!generator.WriteFile(path)) {
+            std::printf("ostimlog: could not write %s\n", path.string().c_str());
+            return false;
+        }
+        auto generateTime = Clock::now() - generateStart;
+        const OStimLogGeneratorStats& stats = generator.GetStats();
+
+        SizeClassRun run;
+        bool ran = run.Run(path);
+        SceneResumeScan scan;
+        auto resume = MeasureResume(path, scan);
+        SliceRun slices = MeasureSlices(path);
+        fs::remove(path);
+        if (!ran) {
+            std::printf("ostimlog: could not read %s\n", path.string().c_str());
+            return false;
+        }
+
+        double megabytes = static_cast<double>(stats.bytes) / (1024.0 * 1024.0);
+        auto read = run.total - run.parse - run.dedup;
+        std::printf("%s: %llu lines, %llu scenes, generated at %.0f MB/s, tailer %.0f MB/s, total %.0f MB/s\n",
+                    label.c_str(), static_cast<unsigned long long>(stats.lines),
+                    static_cast<unsigned long long>(stats.scenes), megabytes / Seconds(generateTime),
+                    megabytes / Seconds(read), megabytes / Seconds(run.total));
+        PrintBenchResult(label + " tailer read + line split", run.lines, NsPerLine(read, run.lines));
+        PrintBenchResult(label + " classify + parse", run.lines, NsPerLine(run.parse, run.lines));
+        PrintBenchResult(label + " dedup (per event line)", run.events, NsPerLine(run.dedup, run.events));
+        PrintBenchResult(label + " resume at tail (" + std::to_string(scan.Lines()) + " lines back)", 1,
+                         std::chrono::duration<double, std::nano>(resume).count());
+        std::printf("%s: %llu slices of <= %zu lines / %lld ms, longest %.2f ms; one unbudgeted read %.2f ms\n",
+                    label.c_str(), static_cast<unsigned long long>(slices.slices), kSliceLines,
+                    static_cast<long long>(kSliceTime.count()),
+                    std::chrono::duration<double, std::milli>(slices.longest).count(),
+                    std::chrono::duration<double, std::milli>(run.total).count());
+
+        if (run.lines != stats.lines || run.events != stats.EventLines() || slices.events != run.events) {
+            std::printf("%s: read %llu lines / %llu events, generator wrote %llu / %llu\n", label.c_str(),
+                        static_cast<unsigned long long>(run.lines), static_cast<unsigned long long>(run.events),
+                        static_cast<unsigned long long>(stats.lines),
+                        static_cast<unsigned long long>(stats.EventLines()));
+            return false;
+        }
+        if (run.suppressed > 0) {
+            std::printf("%s: dedup dropped %llu timestamped lines\n", label.c_str(),
+                        static_cast<unsigned long long>(run.suppressed));
+        }
+        return true;
+    }
+}
+
+// Generates OStim.log files from 64K up to the given size (default 256M) and measures the
+// reader side on each, plus what resuming at the tail and slicing a backlog cost. Also checks that every generated event line parses as one.
+int RunOStimLogBench(int argc, char** argv) {
+    std::uint64_t maxBytes = argc > 0 ? ParseByteSize(argv[0]) : 0;
+    if (maxBytes == 0) {
+        maxBytes = 256ull << 20;
+    }
+
+    fs::path directory = fs::temp_directory_path() / ("osurvival_ostimlog_" + std::to_string(::getpid()));
+    fs::create_directories(directory);
+
+    bool matched = true;
+    for (std::uint64_t bytes : kSizeClasses) {
+        if (bytes > maxBytes) {
+            break;
+        }
+        matched &= ReportSizeClass(directory, bytes);
+    }
+
+    fs::remove_all(directory);
+    return matched ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/ActorSnapshot.h"
+#include "tools/bench/Bench.h"
+
+namespace {
+    constexpr float kRadii[] = {500.0f, 1000.0f, 3000.0f};
+
+    struct Actors {
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> z;
+    };
+
+    // Spread over a cell-sized box around the origin so every band has members.
+    Actors MakeActors(std::size_t count, std::uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> horizontal(-4000.0f, 4000.0f);
+        std::uniform_real_distribution<float> vertical(-300.0f, 300.0f);
+
+        Actors actors;
+        for (std::size_t i = 0; i < count; i++) {
+            actors.x.push_back(horizontal(rng));
+            actors.y.push_back(horizontal(rng));
+            actors.z.push_back(vertical(rng));
+        }
+        return actors;
+    }
+
+    ProximityLimits MakeLimits() {
+        ProximityLimits limits;
+        for (std::size_t k = 0; k < std::size(kRadii); k++) {
+            limits.squared[k] = kRadii[k] * kRadii[k];
+        }
+        return limits;
+    }
+
+    // What the plugin did before: one walk per radius, a sqrt per actor.
+    void LegacyBands(const Actors& actors, std::uint8_t* masks) {
+        std::size_t count = actors.x.size();
+        for (std::size_t i = 0; i < count; i++) {
+            masks[i] = 0;
+        }
+        for (std::size_t k = 0; k < std::size(kRadii); k++) {
+            for (std::size_t i = 0; i < count; i++) {
+                float distance = std::sqrt(actors.x[i] * actors.x[i] + actors.y[i] * actors.y[i] +
+                                           actors.z[i] * actors.z[i]);
+                if (distance <= kRadii[k]) {
+                    masks[i] |= static_cast<std::uint8_t>(1u << k);
+                }
+            }
+        }
+    }
+
+    bool CheckMatchesLegacy(const Actors& actors, const ProximityLimits& limits) {
+        std::size_t count = actors.x.size();
+        std::vector<std::uint8_t> expected(count), scalar(count), kernel(count);
+        LegacyBands(actors, expected.data());
+        ComputeProximityBandsScalar(actors.x.data(), actors.y.data(), actors.z.data(), count, 0.0f, 0.0f, 0.0f,
+                                    limits, scalar.data());
+        ComputeProximityBands(actors.x.data(), actors.y.data(), actors.z.data(), count, 0.0f, 0.0f, 0.0f, limits,
+                              kernel.data());
+        if (scalar != expected || kernel != expected) {
+            std::printf("proximity mismatch at %zu actors\n", count);
+            return false;
+        }
+        return true;
+    }
+
+    void FillSnapshot(ActorSnapshot& snapshot, const Actors& actors, float drift) {
+        snapshot.Begin(0.0f, 0.0f, 0.0f);
+        for (std::size_t i = 0; i < actors.x.size(); i++) {
+            snapshot.Add(static_cast<std::uint32_t>(i + 1), 0x01000000u, actors.x[i] + drift, actors.y[i], actors.z[i], 0);
+        }
+        snapshot.End();
+    }
+}
+
+int RunProximityBench(int argc, char** argv) {
+    std::size_t iterations = ParseIterations(argc, argv, 200'000);
+    ProximityLimits limits = MakeLimits();
+
+    for (std::size_t count : {10, 100, 1000}) {
+        Actors actors = MakeActors(count, static_cast<std::uint32_t>(count));
+        if (!CheckMatchesLegacy(actors, limits)) {
+            return 1;
+        }
+
+        std::size_t runs = std::max<std::size_t>(1000, iterations * 10 / count);
+        std::vector<std::uint8_t> masks(count);
+        std::string prefix = "proximity/" + std::to_string(count) + " actors/";
+
+        double legacy = MeasureNsPerOp(runs, [&](std::size_t) {
+            LegacyBands(actors, masks.data());
+            KeepAlive(masks[0]);
+        });
+        PrintBenchResult(prefix + "sqrt, one walk per radius", runs, legacy);
+
+        double scalar = MeasureNsPerOp(runs, [&](std::size_t) {
+            ComputeProximityBandsScalar(actors.x.data(), actors.y.data(), actors.z.data(), count, 0.0f, 0.0f, 0.0f,
+                                        limits, masks.data());
+            KeepAlive(masks[0]);
+        });
+        PrintBenchResult(prefix + "squared, all bands (scalar)", runs, scalar);
+
+        double kernel = MeasureNsPerOp(runs, [&](std::size_t) {
+            ComputeProximityBands(actors.x.data(), actors.y.data(), actors.z.data(), count, 0.0f, 0.0f, 0.0f, limits,
+                                  masks.data());
+            KeepAlive(masks[0]);
+        });
+        PrintBenchResult(prefix + "squared, all bands (kernel)", runs, kernel);
+
+        ActorSnapshot snapshot{kRadii[0], kRadii[1], kRadii[2]};
+        double moving = MeasureNsPerOp(runs, [&](std::size_t i) {
+            FillSnapshot(snapshot, actors, (i & 1) ? 100.0f : 0.0f);
+            KeepAlive(snapshot);
+        });
+        PrintBenchResult(prefix + "snapshot refresh, actors moving", runs, moving);
+
+        double still = MeasureNsPerOp(runs, [&](std::size_t) {
+            FillSnapshot(snapshot, actors, 0.0f);
+            KeepAlive(snapshot);
+        });
+        PrintBenchResult(prefix + "snapshot refresh, nothing moved", runs, still);
+
+        std::printf("speedup (%zu actors, kernel vs sqrt walks): %.1fx\n", count, legacy / kernel);
+    }
+    return 0;
+}
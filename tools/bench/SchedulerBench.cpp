@@ -0,0 +1,90 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#include "core/DeadlineScheduler.h"
+#include "tools/bench/Bench.h"
+
+namespace {
+    using std::chrono::milliseconds;
+
+    constexpr std::size_t kMonitorTasks = 15;
+
+    // The monitor's task set outside a scene, with time scaled down (one second of game time per
+    // `second`): everything parked except the 5 s log poll, against the old loop that woke every
+    // second and ran all checks.
+    void ReportIdleWakeups(milliseconds second, std::size_t seconds) {
+        DeadlineScheduler scheduler;
+        auto start = DeadlineScheduler::Clock::now();
+        milliseconds logPoll = second * 5;
+        scheduler.Add("log", [logPoll](DeadlineScheduler::TimePoint now) { return now + logPoll; }, start);
+        for (std::size_t i = 1; i < kMonitorTasks; i++) {
+            scheduler.Add("parked", [](DeadlineScheduler::TimePoint) { return DeadlineScheduler::kNever; }, start);
+        }
+
+        std::thread runner([&] { scheduler.Run(); });
+        std::this_thread::sleep_for(second * seconds);
+        scheduler.Stop();
+        runner.join();
+
+        std::printf("idle over %zu s: %llu wakeups, %llu task runs (1 s poll loop: %zu wakeups, %zu checks)\n", seconds,
+                    static_cast<unsigned long long>(scheduler.Wakeups()),
+                    static_cast<unsigned long long>(scheduler.Runs()), seconds, seconds * kMonitorTasks);
+    }
+
+    void ReportWakeLatency(std::size_t iterations) {
+        DeadlineScheduler scheduler;
+        std::atomic<std::size_t> runs{0};
+        std::atomic<long long> totalNs{0};
+        std::atomic<long long> wokenAt{0};
+
+        std::size_t id = scheduler.Add("woken", [&](DeadlineScheduler::TimePoint) {
+            long long started = wokenAt.load();
+            if (started != 0) {
+                totalNs += DeadlineScheduler::Clock::now().time_since_epoch().count() - started;
+                runs++;
+            }
+            return DeadlineScheduler::kNever;
+        }, DeadlineScheduler::kNever);
+
+        std::thread runner([&] { scheduler.Run(); });
+        for (std::size_t i = 0; i < iterations; i++) {
+            std::size_t before = runs.load();
+            wokenAt = DeadlineScheduler::Clock::now().time_since_epoch().count();
+            scheduler.Wake(id);
+            while (runs.load() == before) {
+                std::this_thread::yield();
+            }
+        }
+        scheduler.Stop();
+        runner.join();
+
+        PrintBenchResult("Wake() to task start", iterations,
+                         static_cast<double>(totalNs.load()) / static_cast<double>(iterations));
+    }
+
+    void ReportSubSecondTask(milliseconds window, milliseconds interval) {
+        DeadlineScheduler scheduler;
+        scheduler.Add("fast", [interval](DeadlineScheduler::TimePoint now) { return now + interval; },
+                      DeadlineScheduler::Clock::now());
+
+        std::thread runner([&] { scheduler.Run(); });
+        std::this_thread::sleep_for(window);
+        scheduler.Stop();
+        runner.join();
+
+        std::printf("100 ms task: %llu runs in %lld ms (expected ~%lld)\n",
+                    static_cast<unsigned long long>(scheduler.Runs()), static_cast<long long>(window.count()),
+                    static_cast<long long>(window / interval) + 1);
+    }
+}
+
+int RunSchedulerBench(int argc, char** argv) {
+    std::size_t iterations = ParseIterations(argc, argv, 2000);
+
+    ReportIdleWakeups(milliseconds(100), 30);
+    ReportWakeLatency(iterations);
+    ReportSubSecondTask(milliseconds(1000), milliseconds(100));
+    return 0;
+}
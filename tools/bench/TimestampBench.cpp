@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/TimestampFormatter.h"
+#include "tools/bench/Bench.h"
+
+namespace {
+    // The per-line formatting the log writers used before TimestampFormatter.
+    std::string LegacyTimestamp(std::chrono::system_clock::time_point now) {
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
+        std::time_t time_t = std::chrono::system_clock::to_time_t(now);
+        std::tm buf;
+        TimestampFormatter::ToLocalTime(time_t, buf);
+        std::stringstream ss;
+        ss << std::put_time(&buf, "%Y-%m-%d %H:%M:%S");
+        ss << "." << std::setfill('0') << std::setw(3) << ms.count();
+        return ss.str();
+    }
+
+    bool CheckMatchesLegacy() {
+        auto& formatter = TimestampFormatter::GetSingleton();
+        auto base = std::chrono::system_clock::now();
+
+        for (int step = 0; step < 5000; step++) {
+            auto time = base + std::chrono::milliseconds(step * 7);
+            char text[TimestampFormatter::kMillisLength];
+            std::size_t length = formatter.FormatMillis(time, text);
+            std::string expected = LegacyTimestamp(time);
+            if (std::string_view(text, length) != expected) {
+                std::printf("timestamp mismatch: %.*s vs %s\n", static_cast<int>(length), text, expected.c_str());
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+int RunTimestampBench(int argc, char** argv) {
+    std::size_t iterations = ParseIterations(argc, argv, 2'000'000);
+    auto& formatter = TimestampFormatter::GetSingleton();
+
+    if (!CheckMatchesLegacy()) {
+        return 1;
+    }
+
+    // Advance a millisecond per call so the cached path also crosses second boundaries.
+    auto base = std::chrono::system_clock::now();
+    auto at = [base](std::size_t i) { return base + std::chrono::milliseconds(i); };
+
+    double legacy = MeasureNsPerOp(iterations, [&](std::size_t i) {
+        std::string text = LegacyTimestamp(at(i));
+        KeepAlive(text);
+    });
+    PrintBenchResult("timestamp/stringstream+put_time", iterations, legacy);
+
+    double cached = MeasureNsPerOp(iterations, [&](std::size_t i) {
+        char text[TimestampFormatter::kMillisLength];
+        formatter.FormatMillis(at(i), text);
+        KeepAlive(text);
+    });
+    PrintBenchResult("timestamp/cached into char buffer", iterations, cached);
+
+    double cachedNow = MeasureNsPerOp(iterations, [&](std::size_t) {
+        char text[TimestampFormatter::kMillisLength];
+        formatter.FormatMillis(std::chrono::system_clock::now(), text);
+        KeepAlive(text);
+    });
+    PrintBenchResult("timestamp/cached with system_clock::now", iterations, cachedNow);
+
+    unsigned threadCount = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned t = 0; t < threadCount; t++) {
+        threads.emplace_back([&] {
+            for (std::size_t i = 0; i < iterations; i++) {
+                char text[TimestampFormatter::kMillisLength];
+                formatter.FormatMillis(std::chrono::system_clock::now(), text);
+                KeepAlive(text);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    PrintBenchResult("timestamp/cached, " + std::to_string(threadCount) + " threads (per thread)", iterations,
+                     elapsed / static_cast<double>(iterations));
+
+    std::printf("speedup (single thread): %.1fx\n", legacy / cached);
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include <unistd.h>
+
+#include "core/DirectoryWatcher.h"
+#include "tools/bench/Bench.h"
+
+namespace {
+    namespace fs = std::filesystem;
+    using std::chrono::milliseconds;
+
+    constexpr std::size_t kLinesPerBurst = 200;
+
+    // Two stand-in SKSE log folders; bursts of OStim.log appends (one write per line, as OStim
+    // flushes them) go to the second one, plus unrelated log writes next to it that must not
+    // signal. Reports raw notification records against the coalesced signals and how long after
+    // a burst started its signal arrived.
+    void ReportBurstCoalescing(std::size_t bursts) {
+        fs::path root = fs::temp_directory_path() / ("osurvival_watcher_" + std::to_string(::getpid()));
+        fs::path primary = root / "primary";
+        fs::path secondary = root / "secondary";
+        fs::create_directories(primary);
+        fs::create_directories(secondary);
+
+        DirectoryWatcher watcher;
+        if (!watcher.Start({primary, secondary}, "OStim.log")) {
+            std::printf("watcher: could not watch %s\n", root.string().c_str());
+            fs::remove_all(root);
+            return;
+        }
+
+        std::atomic<long long> burstStartedAt{0};
+        std::atomic<std::size_t> signals{0};
+        long long totalLatencyNs = 0;
+        std::thread waiter([&] {
+            while (watcher.Wait() == DirectoryWatcher::Result::kChanged) {
+                totalLatencyNs += std::chrono::steady_clock::now().time_since_epoch().count() - burstStartedAt.load();
+                signals++;
+            }
+        });
+
+        std::ofstream log(secondary / "OStim.log", std::ios::app);
+        std::ofstream other(secondary / "Other.log", std::ios::app);
+        for (std::size_t burst = 0; burst < bursts; burst++) {
+            std::size_t before = signals.load();
+            burstStartedAt = std::chrono::steady_clock::now().time_since_epoch().count();
+            for (std::size_t line = 0; line < kLinesPerBurst; line++) {
+                log << "[00:00:00.000] [info] [Thread.cpp:0] thread 1 changed to animation Bench" << line << '\n';
+                log.flush();
+                other << "unrelated " << line << '\n';
+                other.flush();
+            }
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+            while (signals.load() == before && std::chrono::steady_clock::now() < deadline) {
+                std::this_thread::sleep_for(milliseconds(1));
+            }
+            // Let the window close so the next burst starts a fresh signal.
+            std::this_thread::sleep_for(DirectoryWatcher::kDefaultCoalesceWindow * 2);
+        }
+
+        watcher.Stop();
+        waiter.join();
+        DirectoryWatcher::Stats stats = watcher.GetStats();
+        watcher.Close();
+        fs::remove_all(root);
+
+        std::printf("%zu bursts x %zu appends: %llu notification records -> %llu signals, %llu overflows\n", bursts,
+                    kLinesPerBurst, static_cast<unsigned long long>(stats.records),
+                    static_cast<unsigned long long>(stats.signals), static_cast<unsigned long long>(stats.overflows));
+        if (signals.load() > 0) {
+            PrintBenchResult("burst start to signal (incl. 50 ms window)", signals.load(),
+                             static_cast<double>(totalLatencyNs) / static_cast<double>(signals.load()));
+        }
+    }
+}
+
+int RunWatcherBench(int argc, char** argv) {
+    std::size_t bursts = ParseIterations(argc, argv, 20);
+
+    ReportBurstCoalescing(bursts);
+    return 0;
+}
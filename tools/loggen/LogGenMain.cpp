@@ -0,0 +1,90 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+
+#include "tools/loggen/OStimLogGenerator.h"
+
+// Writes a synthetic OStim.log for replay and benchmark runs; see OStimLogProfile for what
+// each option controls.
+
+namespace {
+    int PrintUsage() {
+        std::printf(
+            "usage: osurvival_loggen <out.log> [--scenes n] [--size bytes[K|M|G]] [--actors n]\n"
+            "                        [--scene-min m] [--idle-min m] [--nodes-per-min r] [--speeds-per-node n]\n"
+            "                        [--voice-lines n] [--orgasms n] [--warnings-per-min r] [--noise-per-min r]\n"
+            "                        [--seed n] [--crlf share] [--partial-tail]\n");
+        return 1;
+    }
+
+    void PrintStats(const OStimLogGeneratorStats& stats) {
+        auto count = [](std::uint64_t value) { return static_cast<unsigned long long>(value); };
+        std::printf("%llu lines, %.1f MB, %llu scenes\n", count(stats.lines),
+                    static_cast<double>(stats.bytes) / (1024.0 * 1024.0), count(stats.scenes));
+        std::printf("  %llu menu transitions, %llu node changes, %llu speed changes, %llu voice sets, %llu orgasms, "
+                    "%llu scene-end lines\n",
+                    count(stats.menuTransitions), count(stats.nodeChanges), count(stats.speedChanges),
+                    count(stats.voiceSets), count(stats.orgasms), count(stats.sceneEnds));
+        std::printf("  %llu warnings, %llu noise lines, %llu event lines in total\n", count(stats.warnings),
+                    count(stats.noise), count(stats.EventLines()));
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        return PrintUsage();
+    }
+
+    OStimLogProfile profile;
+    for (int i = 2; i < argc; i++) {
+        std::string_view arg = argv[i];
+        if (arg == "--partial-tail") {
+            profile.partialLastLine = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return PrintUsage();
+        }
+        const char* value = argv[++i];
+        if (arg == "--scenes") {
+            profile.scenes = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--size") {
+            profile.targetBytes = ParseByteSize(value);
+            if (profile.targetBytes == 0) {
+                return PrintUsage();
+            }
+        } else if (arg == "--actors") {
+            profile.actorsPerScene = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--scene-min") {
+            profile.sceneMinutes = std::atof(value);
+        } else if (arg == "--idle-min") {
+            profile.idleMinutes = std::atof(value);
+        } else if (arg == "--nodes-per-min") {
+            profile.nodeChangesPerMinute = std::atof(value);
+        } else if (arg == "--speeds-per-node") {
+            profile.speedChangesPerNode = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--voice-lines") {
+            profile.voiceSetLinesPerActor = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--orgasms") {
+            profile.orgasmsPerScene = static_cast<std::uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--warnings-per-min") {
+            profile.warningsPerMinute = std::atof(value);
+        } else if (arg == "--noise-per-min") {
+            profile.noisePerMinute = std::atof(value);
+        } else if (arg == "--seed") {
+            profile.seed = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--crlf") {
+            profile.crlfShare = std::atof(value);
+        } else {
+            return PrintUsage();
+        }
+    }
+
+    OStimLogGenerator generator(profile);
+    if (!generator.WriteFile(argv[1])) {
+        std::fprintf(stderr, "cannot write %s\n", argv[1]);
+        return 1;
+    }
+    PrintStats(generator.GetStats());
+    return 0;
+}
@@ -0,0 +1,355 @@
+#include "tools/loggen/OStimLogGenerator.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+
+namespace {
+    constexpr std::size_t kFlushSize = 1024 * 1024;
+
+    struct ActorName {
+        std::string_view name;
+        std::string_view gender;
+    };
+
+    // Actor 0 is the player and is in every scene.
+    constexpr std::array<ActorName, 12> kActors = {{
+        {"Player", "Male"},
+        {"Lydia", "Female"},
+        {"Aela the Huntress", "Female"},
+        {"Serana", "Female"},
+        {"Ysolda", "Female"},
+        {"Camilla Valerius", "Female"},
+        {"Mjoll the Lioness", "Female"},
+        {"Farkas", "Male"},
+        {"Vilkas", "Male"},
+        {"Marcurio", "Male"},
+        {"Brelyna Maryon", "Female"},
+        {"Jordis the Sword-Maiden", "Female"},
+    }};
+
+    constexpr std::array<std::string_view, 5> kPacks = {"OStim", "BB", "OARE", "Billyy", "NMS"};
+    constexpr std::array<std::string_view, 8> kPoses = {"StandingEmbrace", "KneelingHold", "SittingCuddle",
+                                                        "LyingSpoon",      "WallLean",     "ChairLap",
+                                                        "BedsideKiss",     "SlowDance"};
+    constexpr std::array<std::string_view, 6> kVoiceSets = {"VoiceFemaleYoungEager", "VoiceFemaleNord",
+                                                            "VoiceMaleBrute",        "VoiceFemaleSultry",
+                                                            "VoiceMaleEvenToned",    "VoiceFemaleCommander"};
+    constexpr int kMaxSpeed = 4;
+
+    std::uint64_t Round(double value) {
+        return value > 0 ? static_cast<std::uint64_t>(std::llround(value)) : 0;
+    }
+
+    void AppendNumber(std::string& out, std::uint64_t value) {
+        char digits[20];
+        auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+        out.append(digits, end);
+    }
+
+    void AppendNode(std::string& out, std::uint32_t node) {
+        out += kPacks[(node / kPoses.size()) % kPacks.size()];
+        out += '_';
+        out += kPoses[node % kPoses.size()];
+        out += '_';
+        AppendNumber(out, node % 7);
+    }
+}
+
+OStimLogGenerator::OStimLogGenerator(const OStimLogProfile& profile) : _profile(profile), _random(profile.seed) {
+    _profile.actorsPerScene =
+        std::clamp<std::uint32_t>(_profile.actorsPerScene, 1, static_cast<std::uint32_t>(kActors.size()));
+    _profile.sceneMinutes = std::max(_profile.sceneMinutes, 0.1);
+    _profile.idleMinutes = std::max(_profile.idleMinutes, 0.0);
+    _buffer.reserve(kFlushSize + 1024);
+}
+
+bool OStimLogGenerator::WriteFile(const std::filesystem::path& path) {
+    std::FILE* out = std::fopen(path.string().c_str(), "wb");
+    if (!out) {
+        return false;
+    }
+    bool written = Write(out);
+    return std::fclose(out) == 0 && written;
+}
+
+bool OStimLogGenerator::Write(std::FILE* out) {
+    _stats = {};
+    std::uint64_t sceneStartMs = 0;
+    std::uint64_t sceneLengthMs = Round(_profile.sceneMinutes * 60000.0);
+    std::uint64_t idleLengthMs = Round(_profile.idleMinutes * 60000.0);
+
+    while (!IsDone()) {
+        PlanScene(sceneStartMs);
+        _stats.scenes++;
+        for (const PendingLine& line : _scene) {
+            AppendLine(line);
+            if (!FlushBuffer(out, false)) {
+                return false;
+            }
+            if (_profile.targetBytes > 0 && _stats.bytes >= _profile.targetBytes) {
+                break;
+            }
+        }
+        sceneStartMs += sceneLengthMs + idleLengthMs;
+    }
+
+    // A complete speed change but for its newline, so a reader that wrongly takes it in would
+    // see one event too many.
+    if (_profile.partialLastLine) {
+        std::size_t before = _buffer.size();
+        AppendPrefix(sceneStartMs, "info", "Thread.cpp:322");
+        _buffer += "thread 0 changed speed to ";
+        AppendNumber(_buffer, 1 + Pick(kMaxSpeed));
+        _stats.bytes += _buffer.size() - before;
+    }
+    return FlushBuffer(out, true);
+}
+
+bool OStimLogGenerator::IsDone() const {
+    if (_profile.targetBytes > 0) {
+        return _stats.bytes >= _profile.targetBytes;
+    }
+    return _stats.scenes >= _profile.scenes;
+}
+
+void OStimLogGenerator::PlanScene(std::uint64_t sceneStartMs) {
+    _scene.clear();
+    std::uint64_t lengthMs = std::max<std::uint64_t>(Round(_profile.sceneMinutes * 60000.0), 1000);
+    std::uint64_t idleMs = Round(_profile.idleMinutes * 60000.0);
+    std::uint64_t endMs = sceneStartMs + lengthMs;
+
+    _cast.assign(1, 0);
+    while (_cast.size() < _profile.actorsPerScene) {
+        std::uint32_t actor = 1 + Pick(static_cast<std::uint32_t>(kActors.size() - 1));
+        if (std::find(_cast.begin(), _cast.end(), actor) == _cast.end()) {
+            _cast.push_back(actor);
+        }
+    }
+
+    // The menu picks the starting node, then OStim looks up a voice set for every actor.
+    std::uint32_t firstNode = _node++;
+    _scene.push_back({sceneStartMs, LineKind::kMenuTransition, 0, firstNode});
+    for (std::uint32_t actor : _cast) {
+        for (std::uint32_t i = 0; i < _profile.voiceSetLinesPerActor; i++) {
+            _scene.push_back({sceneStartMs + 1 + Pick(20), LineKind::kVoiceSet, actor, Pick(3)});
+        }
+    }
+
+    // Node changes split the scene evenly; each node gets its speed changes at random points
+    // inside its own stretch.
+    std::uint64_t nodes = std::max<std::uint64_t>(1, Round(_profile.nodeChangesPerMinute * _profile.sceneMinutes));
+    std::uint64_t nodeLengthMs = std::max<std::uint64_t>(lengthMs / nodes, 1);
+    for (std::uint64_t i = 0; i < nodes; i++) {
+        std::uint64_t nodeStartMs = sceneStartMs + 25 + i * nodeLengthMs;
+        std::uint32_t node = i == 0 ? firstNode : _node++;
+        _scene.push_back({nodeStartMs, LineKind::kNodeChange, 0, node});
+        for (std::uint32_t s = 0; s < _profile.speedChangesPerNode; s++) {
+            _scene.push_back({PickTime(nodeStartMs + 1, nodeLengthMs - 1), LineKind::kSpeedChange, 0,
+                              1 + Pick(kMaxSpeed)});
+        }
+    }
+
+    for (std::uint32_t i = 0; i < _profile.orgasmsPerScene; i++) {
+        _scene.push_back({PickTime(sceneStartMs + lengthMs / 2, lengthMs / 2), LineKind::kOrgasm,
+                          _cast[Pick(static_cast<std::uint32_t>(_cast.size()))], 0});
+    }
+
+    std::uint64_t warnings = Round(_profile.warningsPerMinute * _profile.sceneMinutes);
+    for (std::uint64_t i = 0; i < warnings; i++) {
+        _scene.push_back({PickTime(sceneStartMs, lengthMs), LineKind::kWarning,
+                          _cast[Pick(static_cast<std::uint32_t>(_cast.size()))], Pick(3)});
+    }
+
+    std::uint64_t noise = Round(_profile.noisePerMinute * (_profile.sceneMinutes + _profile.idleMinutes));
+    for (std::uint64_t i = 0; i < noise; i++) {
+        _scene.push_back({PickTime(sceneStartMs, lengthMs + idleMs), LineKind::kNoise,
+                          _cast[Pick(static_cast<std::uint32_t>(_cast.size()))], Pick(4)});
+    }
+
+    _scene.push_back({endMs, LineKind::kStopping, 0, 0});
+    _scene.push_back({endMs + 2, LineKind::kClosing, 0, 0});
+
+    // Stable, so lines planned for the same millisecond keep their planned order.
+    std::stable_sort(_scene.begin(), _scene.end(),
+                     [](const PendingLine& a, const PendingLine& b) { return a.timeMs < b.timeMs; });
+}
+
+void OStimLogGenerator::AppendPrefix(std::uint64_t timeMs, std::string_view level, std::string_view source) {
+    std::uint64_t seconds = timeMs / 1000;
+    char stamp[] = "[00:00:00.000] ";
+    auto put2 = [&](std::size_t at, std::uint64_t value) {
+        stamp[at] = static_cast<char>('0' + value / 10);
+        stamp[at + 1] = static_cast<char>('0' + value % 10);
+    };
+    put2(1, (seconds / 3600) % 24);
+    put2(4, (seconds / 60) % 60);
+    put2(7, seconds % 60);
+    stamp[10] = static_cast<char>('0' + (timeMs % 1000) / 100);
+    put2(11, timeMs % 100);
+    _buffer.append(stamp, sizeof(stamp) - 1);
+
+    _buffer += '[';
+    _buffer += level;
+    _buffer += "] [";
+    _buffer += source;
+    _buffer += "] ";
+}
+
+void OStimLogGenerator::AppendLine(const PendingLine& line) {
+    std::size_t before = _buffer.size();
+    const ActorName& actor = kActors[line.actor];
+
+    switch (line.kind) {
+        case LineKind::kMenuTransition:
+            AppendPrefix(line.timeMs, "info", "OStimMenu.h:48");
+            _buffer += "UI_TransitionRequest {";
+            AppendNode(_buffer, line.value);
+            _buffer += '}';
+            _stats.menuTransitions++;
+            break;
+
+        case LineKind::kVoiceSet:
+            AppendPrefix(line.timeMs, "info", "VoiceSetManager.cpp:61");
+            if (line.value == 2) {
+                _buffer += "no voice set found for actor ";
+                _buffer += actor.name;
+                _buffer += ", using default";
+            } else {
+                _buffer += "voice set ";
+                _buffer += kVoiceSets[Pick(static_cast<std::uint32_t>(kVoiceSets.size()))];
+                _buffer += " found for actor ";
+                _buffer += actor.name;
+                _buffer += line.value == 0 ? " by voice type" : ", using race default";
+            }
+            _stats.voiceSets++;
+            break;
+
+        case LineKind::kNodeChange:
+            AppendPrefix(line.timeMs, "info", "Thread.cpp:195");
+            _buffer += "thread 0 changed to node ";
+            AppendNode(_buffer, line.value);
+            _stats.nodeChanges++;
+            break;
+
+        case LineKind::kSpeedChange:
+            AppendPrefix(line.timeMs, "info", "Thread.cpp:322");
+            _buffer += "thread 0 changed speed to ";
+            AppendNumber(_buffer, line.value);
+            _stats.speedChanges++;
+            break;
+
+        case LineKind::kOrgasm:
+            AppendPrefix(line.timeMs, "info", "ActorEvents.cpp:57");
+            _buffer += "sending ostim_actor_orgasm event for actor:";
+            _buffer += actor.name;
+            _buffer += ", gender:";
+            _buffer += actor.gender;
+            _stats.orgasms++;
+            break;
+
+        case LineKind::kStopping:
+            AppendPrefix(line.timeMs, "info", "ThreadManager.cpp:174");
+            _buffer += "trying to stop thread 0";
+            _stats.sceneEnds++;
+            break;
+
+        case LineKind::kClosing:
+            AppendPrefix(line.timeMs, "info", "Thread.cpp:634");
+            _buffer += "closing thread 0";
+            _stats.sceneEnds++;
+            break;
+
+        case LineKind::kWarning:
+            // The first shape carries a speed change and the last a node name; both must still
+            // be dropped as warnings.
+            if (line.value == 0) {
+                AppendPrefix(line.timeMs, "warning", "Thread.cpp:330");
+                _buffer += "thread 0 changed speed to ";
+                AppendNumber(_buffer, kMaxSpeed + 1 + Pick(4));
+                _buffer += " but the node only has ";
+                AppendNumber(_buffer, kMaxSpeed);
+                _buffer += " speeds";
+            } else if (line.value == 1) {
+                AppendPrefix(line.timeMs, "warning", "ExpressionUtil.cpp:40");
+                _buffer += "no expression found for ";
+                _buffer += actor.name;
+            } else {
+                AppendPrefix(line.timeMs, "warning", "Graph.cpp:233");
+                _buffer += "node ";
+                AppendNode(_buffer, _node + Pick(64));
+                _buffer += " has no furniture type, skipping";
+            }
+            _stats.warnings++;
+            break;
+
+        case LineKind::kNoise:
+            if (line.value == 0) {
+                AppendPrefix(line.timeMs, "debug", "Graph.cpp:412");
+                _buffer += "evaluating ";
+                AppendNumber(_buffer, 8 + Pick(200));
+                _buffer += " candidate nodes for furniture none";
+            } else if (line.value == 1) {
+                AppendPrefix(line.timeMs, "info", "ActorUtil.cpp:120");
+                _buffer += "updated heel offset for ";
+                _buffer += actor.name;
+            } else if (line.value == 2) {
+                AppendPrefix(line.timeMs, "debug", "Thread.cpp:512");
+                _buffer += "thread 0 aligned actor ";
+                AppendNumber(_buffer, Pick(_profile.actorsPerScene));
+                _buffer += " to offset 0.000000 0.000000 0.000000 rotation 0.000000";
+            } else {
+                AppendPrefix(line.timeMs, "trace", "FaceData.cpp:88");
+                _buffer += "expression update tick ";
+                AppendNumber(_buffer, line.timeMs);
+            }
+            _stats.noise++;
+            break;
+    }
+
+    if (_profile.crlfShare > 0.0 && std::uniform_real_distribution<double>(0.0, 1.0)(_random) < _profile.crlfShare) {
+        _buffer += '\r';
+    }
+    _buffer += '\n';
+    _stats.lines++;
+    _stats.bytes += _buffer.size() - before;
+}
+
+bool OStimLogGenerator::FlushBuffer(std::FILE* out, bool force) {
+    if (_buffer.empty() || (!force && _buffer.size() < kFlushSize)) {
+        return true;
+    }
+    bool written = std::fwrite(_buffer.data(), 1, _buffer.size(), out) == _buffer.size();
+    _buffer.clear();
+    return written;
+}
+
+std::uint64_t ParseByteSize(std::string_view text) {
+    std::uint64_t value = 0;
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc() || end == text.data()) {
+        return 0;
+    }
+
+    std::string_view suffix(end, static_cast<std::size_t>(text.data() + text.size() - end));
+    if (suffix.empty()) {
+        return value;
+    }
+    if (suffix.size() > 1 && suffix.back() != 'B' && suffix.back() != 'b') {
+        return 0;
+    }
+    switch (suffix.front()) {
+        case 'K':
+        case 'k':
+            return value << 10;
+        case 'M':
+        case 'm':
+            return value << 20;
+        case 'G':
+        case 'g':
+            return value << 30;
+        default:
+            return 0;
+    }
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Shape of a synthetic OStim.log. Rates are per simulated minute of scene time; noise lines
+// are written during scenes and during the idle gap between them.
+struct OStimLogProfile {
+    std::uint64_t scenes = 100;
+    std::uint32_t actorsPerScene = 2;
+    double sceneMinutes = 3.0;
+    double idleMinutes = 2.0;
+    double nodeChangesPerMinute = 6.0;
+    std::uint32_t speedChangesPerNode = 2;
+    std::uint32_t voiceSetLinesPerActor = 1;
+    std::uint32_t orgasmsPerScene = 2;
+    double warningsPerMinute = 4.0;
+    double noisePerMinute = 120.0;
+    // When set, scenes keep coming until the output reaches this size and scenes is ignored.
+    std::uint64_t targetBytes = 0;
+    std::uint64_t seed = 1;
+    // Share of lines ending in "\r\n" rather than "\n", as in a log that went through Windows
+    // tools. Zero keeps the output byte-identical to earlier versions for the same seed.
+    double crlfShare = 0.0;
+    // End on an event line without its newline, as in a log read while OStim is writing it.
+    bool partialLastLine = false;
+};
+
+// What was written, by the kind the plugin's classifier will give each line.
+struct OStimLogGeneratorStats {
+    std::uint64_t lines = 0;
+    std::uint64_t bytes = 0;
+    std::uint64_t scenes = 0;
+    std::uint64_t menuTransitions = 0;
+    std::uint64_t nodeChanges = 0;
+    std::uint64_t speedChanges = 0;
+    std::uint64_t voiceSets = 0;
+    std::uint64_t orgasms = 0;
+    std::uint64_t sceneEnds = 0;
+    std::uint64_t warnings = 0;
+    std::uint64_t noise = 0;
+
+    // Lines that parse to an OStimEvent: menu transitions and node changes both count as
+    // node events, and every scene ends with a closing line and a stop line.
+    std::uint64_t EventLines() const {
+        return menuTransitions + nodeChanges + speedChanges + voiceSets + orgasms + sceneEnds;
+    }
+};
+
+// Writes OStim.log text in the exact line shapes the plugin matches on: spdlog's
+// "[time] [level] [file:line] message" prefix, the Thread.cpp node/speed/closing lines, the
+// ThreadManager stop line, OStimMenu transitions, voice-set lookups, ostim_actor_orgasm
+// events, plus [warning] lines (some of which mention speeds or nodes and must still be
+// ignored) and unrelated [debug]/[info] traffic. Output is deterministic for a given seed.
+class OStimLogGenerator {
+public:
+    explicit OStimLogGenerator(const OStimLogProfile& profile);
+
+    // False when a write failed.
+    bool Write(std::FILE* out);
+    bool WriteFile(const std::filesystem::path& path);
+
+    const OStimLogGeneratorStats& GetStats() const { return _stats; }
+
+private:
+    enum class LineKind : std::uint8_t {
+        kNoise,
+        kWarning,
+        kMenuTransition,
+        kVoiceSet,
+        kNodeChange,
+        kSpeedChange,
+        kOrgasm,
+        kClosing,
+        kStopping
+    };
+
+    struct PendingLine {
+        std::uint64_t timeMs;
+        LineKind kind;
+        std::uint32_t actor;
+        std::uint32_t value;
+    };
+
+    bool IsDone() const;
+    void PlanScene(std::uint64_t sceneStartMs);
+    void AppendLine(const PendingLine& line);
+    void AppendPrefix(std::uint64_t timeMs, std::string_view level, std::string_view source);
+    bool FlushBuffer(std::FILE* out, bool force);
+
+    std::uint32_t Pick(std::uint32_t count) { return std::uniform_int_distribution<std::uint32_t>(0, count - 1)(_random); }
+    std::uint64_t PickTime(std::uint64_t from, std::uint64_t length) {
+        return from + std::uniform_int_distribution<std::uint64_t>(0, length ? length - 1 : 0)(_random);
+    }
+
+    OStimLogProfile _profile;
+    std::mt19937_64 _random;
+    OStimLogGeneratorStats _stats;
+
+    std::vector<PendingLine> _scene;
+    std::vector<std::uint32_t> _cast;
+    std::uint32_t _node = 0;
+    std::string _buffer;
+};
+
+// Parses a size such as "512", "64K", "16M" or "2G" (binary units). Zero when malformed.
+std::uint64_t ParseByteSize(std::string_view text);
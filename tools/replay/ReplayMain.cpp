@@ -0,0 +1,515 @@
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/MappedFile.h"
+#include "core/OStimLineFilter.h"
+#include "core/OStimLogTailer.h"
+#include "core/ParallelLogParser.h"
+#include "core/PluginConfig.h"
+#include "core/RewardTable.h"
+#include "core/SceneStateMachine.h"
+
+// Feeds a recorded OStim.log through the same stages the plugin runs (tailer, line filter,
+// scene state machine, interval rewards) and reports throughput, allocations and the time
+// spent in each stage. Lines are handled in batches so every stage can be timed on its own;
+// game time is simulated as a fixed step per line. With --parallel the file is mapped and
+// parsed on worker threads instead, and the chunks are folded through the same stages in file
+// order; --verify runs both ways and checks that they agree.
+
+namespace {
+    std::atomic<std::uint64_t> g_allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* block = std::malloc(size ? size : 1)) {
+        return block;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* block) noexcept {
+    std::free(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept {
+    std::free(block);
+}
+
+namespace {
+    namespace fs = std::filesystem;
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        fs::path log;
+        fs::path ini;
+        std::size_t batchLines = 64 * 1024;
+        std::chrono::milliseconds lineStep{100};
+        unsigned parallel = 0;
+        std::size_t chunkBytes = ParallelLogParser::kDefaultChunkBytes;
+        bool verify = false;
+    };
+
+    struct StageStats {
+        std::string_view name;
+        Clock::duration time{};
+        std::uint64_t allocations = 0;
+    };
+
+    // Times one stage and counts what it allocated.
+    class StageTimer {
+    public:
+        explicit StageTimer(StageStats& stats)
+            : _stats(stats), _start(Clock::now()), _allocations(g_allocations.load(std::memory_order_relaxed)) {}
+
+        ~StageTimer() {
+            _stats.time += Clock::now() - _start;
+            _stats.allocations += g_allocations.load(std::memory_order_relaxed) - _allocations;
+        }
+
+    private:
+        StageStats& _stats;
+        Clock::time_point _start;
+        std::uint64_t _allocations;
+    };
+
+    struct SceneCounts {
+        std::uint64_t events = 0;
+        std::uint64_t starts = 0;
+        std::uint64_t ends = 0;
+        std::uint64_t animationChanges = 0;
+        std::uint64_t speedChanges = 0;
+        std::uint64_t orgasms = 0;
+        std::uint64_t voiceSets = 0;
+    };
+
+    // Order-sensitive FNV-1a over every event that reached the scene stage, so two runs can be
+    // compared without keeping their events.
+    class EventDigest {
+    public:
+        void Add(std::uint64_t line, const OStimLogLine& parsed) {
+            const OStimEvent& event = parsed.event;
+            Add(line);
+            Add(static_cast<std::uint64_t>(event.kind));
+            Add(event.node);
+            Add(event.actor);
+            Add(event.gender);
+            Add(static_cast<std::uint64_t>(static_cast<std::int64_t>(event.speed)));
+            Add(static_cast<std::uint64_t>(event.resetsSpeed) | static_cast<std::uint64_t>(parsed.threadClosing) << 1);
+        }
+
+        std::uint64_t Value() const { return _state; }
+
+    private:
+        void Add(std::uint64_t value) {
+            for (int i = 0; i < 8; i++, value >>= 8) {
+                _state = (_state ^ (value & 0xFF)) * 1099511628211ull;
+            }
+        }
+
+        void Add(std::string_view text) {
+            Add(text.size());
+            for (char c : text) {
+                _state = (_state ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+            }
+        }
+
+        std::uint64_t _state = 14695981039346656037ull;
+    };
+
+    // What the reward stage needs from the scene stage: when the scene state changed.
+    struct SceneMark {
+        std::uint64_t line;
+        bool started;
+        bool active;
+    };
+
+    class Replay {
+    public:
+        explicit Replay(const Options& options) : _options(options) {
+            _lines.reserve(options.batchLines);
+            _parsed.reserve(options.batchLines);
+            _marks.reserve(options.batchLines);
+        }
+
+        bool LoadRewards() {
+            PluginConfig config;
+            if (!_options.ini.empty()) {
+                std::string text;
+                if (!ReadIniText(_options.ini, text)) {
+                    std::fprintf(stderr, "cannot read %s\n", _options.ini.string().c_str());
+                    return false;
+                }
+                ParsePluginConfigText(text, config);
+            }
+
+            _definitions = CollectRewardDefinitions(config);
+            for (auto& definition : _definitions) {
+                // Nearby-NPC conditions need the game world, so those rewards are left out.
+                RewardCondition condition = ParseRewardCondition(definition.requiresNearby);
+                if (!definition.enabled || definition.amount <= 0 || definition.intervalMinutes <= 0 ||
+                    condition != RewardCondition::kNone) {
+                    continue;
+                }
+                RewardTable<RewardDefinition>::Entry entry;
+                entry.label = definition.name;
+                entry.item = &definition;
+                entry.amount = definition.amount;
+                entry.interval = std::chrono::minutes(definition.intervalMinutes);
+                entry.condition = condition;
+                _rewards.Add(std::move(entry));
+            }
+            return true;
+        }
+
+        bool Run() {
+            OStimLogTailer tailer;
+            tailer.SetCandidates({_options.log});
+
+            auto start = Clock::now();
+            std::uint64_t startAllocations = g_allocations.load(std::memory_order_relaxed);
+
+            while (true) {
+                OStimLogTailer::Status status = tailer.Refresh();
+                if (status == OStimLogTailer::Status::kMissing) {
+                    std::fprintf(stderr, "cannot open %s\n", _options.log.string().c_str());
+                    return false;
+                }
+                if (status == OStimLogTailer::Status::kUnchanged) {
+                    break;
+                }
+                tailer.ReadLines([this](std::string_view line) {
+                    _arena.append(line);
+                    _lines.push_back(static_cast<std::uint32_t>(line.size()));
+                    if (_lines.size() == _options.batchLines) {
+                        Flush();
+                    }
+                });
+                if (tailer.GetPosition() >= tailer.GetFileSize()) {
+                    break;
+                }
+            }
+            Flush();
+
+            _bytes = tailer.GetPosition();
+            Finish(start, startAllocations);
+            return true;
+        }
+
+        // Maps the whole file and parses it on worker threads. The chunks come back in file
+        // order and only the line filter's dedup runs here before the scene and reward stages,
+        // so the result matches Run(). What the workers spend is not timed per stage; the time
+        // this thread spent waiting for them is reported as the read.
+        bool RunParallel() {
+            auto start = Clock::now();
+            std::uint64_t startAllocations = g_allocations.load(std::memory_order_relaxed);
+
+            MappedFile file;
+            if (!file.Open(_options.log)) {
+                std::fprintf(stderr, "cannot open %s\n", _options.log.string().c_str());
+                return false;
+            }
+
+            ParallelLogParser parser(_options.parallel, _options.chunkBytes);
+            ParallelLogParser::Stats stats = parser.Parse(file.View(), [this](const ParallelLogParser::Chunk& chunk) {
+                {
+                    StageTimer timer(_parse);
+                    for (const ParallelLogParser::Line& line : chunk.events) {
+                        if (_filter.Admit(line.hash, line.parsed.event)) {
+                            _parsed.push_back({line.index, line.parsed});
+                        }
+                    }
+                }
+                FoldParsed(chunk.firstLine + chunk.lineCount);
+            });
+
+            _workers = parser.GetWorkers();
+            _chunks = stats.chunks;
+            _bytes = stats.bytes;
+            _read.name = "wait";
+            Finish(start, startAllocations);
+            return true;
+        }
+
+        // True when both runs saw the same lines, admitted the same events in the same order
+        // and ended with the same scene, counts and rewards. Prints what differs.
+        bool Matches(const Replay& other) const {
+            bool matches = true;
+            auto check = [&matches](const char* what, std::uint64_t a, std::uint64_t b) {
+                if (a != b) {
+                    std::printf("  mismatch in %s: %llu vs %llu\n", what, static_cast<unsigned long long>(a),
+                                static_cast<unsigned long long>(b));
+                    matches = false;
+                }
+            };
+            check("lines", _lineCount, other._lineCount);
+            check("event digest", _digest.Value(), other._digest.Value());
+            check("events", _counts.events, other._counts.events);
+            check("scene starts", _counts.starts, other._counts.starts);
+            check("scene ends", _counts.ends, other._counts.ends);
+            check("animation changes", _counts.animationChanges, other._counts.animationChanges);
+            check("speed changes", _counts.speedChanges, other._counts.speedChanges);
+            check("orgasms", _counts.orgasms, other._counts.orgasms);
+            check("voice sets", _counts.voiceSets, other._counts.voiceSets);
+            check("rewards issued", _issued, other._issued);
+            check("final speed", static_cast<std::uint64_t>(_state.Speed()),
+                  static_cast<std::uint64_t>(other._state.Speed()));
+            check("final in scene", _state.InScene(), other._state.InScene());
+            if (_state.Animation() != other._state.Animation()) {
+                std::printf("  mismatch in final animation: \"%s\" vs \"%s\"\n", _state.Animation().c_str(),
+                            other._state.Animation().c_str());
+                matches = false;
+            }
+            return matches;
+        }
+
+        void Report() const {
+            double seconds = std::chrono::duration<double>(_elapsed).count();
+            double lines = static_cast<double>(_lineCount);
+
+            std::printf("replay of %s\n", _options.log.string().c_str());
+            if (_workers > 0) {
+                std::printf("  parallel: %u workers, %llu chunks\n", _workers,
+                            static_cast<unsigned long long>(_chunks));
+            }
+            std::printf("  %llu lines, %.1f MB in %.3f s: %.0f lines/s, %.1f MB/s\n",
+                        static_cast<unsigned long long>(_lineCount), static_cast<double>(_bytes) / (1024.0 * 1024.0),
+                        seconds, seconds > 0 ? lines / seconds : 0.0,
+                        seconds > 0 ? static_cast<double>(_bytes) / (1024.0 * 1024.0) / seconds : 0.0);
+            std::printf("  %llu events: %llu scene starts, %llu ends, %llu animation changes, %llu speed changes, "
+                        "%llu orgasms, %llu voice sets\n",
+                        static_cast<unsigned long long>(_counts.events), static_cast<unsigned long long>(_counts.starts),
+                        static_cast<unsigned long long>(_counts.ends),
+                        static_cast<unsigned long long>(_counts.animationChanges),
+                        static_cast<unsigned long long>(_counts.speedChanges),
+                        static_cast<unsigned long long>(_counts.orgasms),
+                        static_cast<unsigned long long>(_counts.voiceSets));
+            std::printf("  %zu unconditional interval rewards, %llu issued over %.0f simulated minutes (%lld ms per line)\n",
+                        _rewards.Size(), static_cast<unsigned long long>(_issued),
+                        std::chrono::duration<double, std::ratio<60>>(_options.lineStep * _lineCount).count(),
+                        static_cast<long long>(_options.lineStep.count()));
+            std::printf("  %llu allocations, %.4f per line\n", static_cast<unsigned long long>(_totalAllocations),
+                        lines > 0 ? static_cast<double>(_totalAllocations) / lines : 0.0);
+
+            std::printf("  %-8s %12s %10s %14s\n", "stage", "total ms", "ns/line", "allocations");
+            for (const StageStats* stage : {&_read, &_parse, &_scene, &_reward}) {
+                double ms = std::chrono::duration<double, std::milli>(stage->time).count();
+                std::printf("  %-8.*s %12.2f %10.1f %14llu\n", static_cast<int>(stage->name.size()),
+                            stage->name.data(), ms, lines > 0 ? ms * 1e6 / lines : 0.0,
+                            static_cast<unsigned long long>(stage->allocations));
+            }
+        }
+
+    private:
+        void Finish(Clock::time_point start, std::uint64_t startAllocations) {
+            _elapsed = Clock::now() - start;
+            _totalAllocations = g_allocations.load(std::memory_order_relaxed) - startAllocations;
+
+            // Everything outside the later stages was spent reading.
+            _read.time = _elapsed - _parse.time - _scene.time - _reward.time;
+            _read.allocations = _totalAllocations - _parse.allocations - _scene.allocations - _reward.allocations;
+        }
+
+        void Flush() {
+            if (_lines.empty()) {
+                return;
+            }
+
+            {
+                StageTimer timer(_parse);
+                std::size_t offset = 0;
+                for (std::size_t i = 0; i < _lines.size(); i++) {
+                    std::string_view line(_arena.data() + offset, _lines[i]);
+                    offset += _lines[i];
+
+                    OStimLogLine parsed;
+                    if (_filter.Parse(line, parsed)) {
+                        _parsed.push_back({_lineCount + i, parsed});
+                    }
+                }
+            }
+
+            FoldParsed(_lineCount + _lines.size());
+            _arena.clear();
+            _lines.clear();
+        }
+
+        // Runs the parsed events through the scene and reward stages; lineEnd is the line after
+        // the last one they were parsed from.
+        void FoldParsed(std::uint64_t lineEnd) {
+            {
+                StageTimer timer(_scene);
+                for (const auto& [line, parsed] : _parsed) {
+                    if (_options.verify) {
+                        _digest.Add(line, parsed);
+                    }
+                    _counts.events++;
+                    if (parsed.event.kind == OStimEventKind::kOrgasm) {
+                        _counts.orgasms++;
+                        continue;
+                    }
+                    if (parsed.event.kind == OStimEventKind::kVoiceSet) {
+                        _counts.voiceSets++;
+                        continue;
+                    }
+
+                    bool wasActive = _state.IsActive();
+                    SceneStateMachine::Step step = _state.Apply(parsed.event);
+                    _counts.starts += step.started;
+                    _counts.ends += step.ended;
+                    _counts.animationChanges += step.animationChanged;
+                    _counts.speedChanges += step.speedChanged;
+                    if (step.started || _state.IsActive() != wasActive) {
+                        _marks.push_back({line, step.started, _state.IsActive()});
+                    }
+                }
+            }
+
+            _lineCount = lineEnd;
+
+            {
+                StageTimer timer(_reward);
+                for (const SceneMark& mark : _marks) {
+                    IssueRewardsUntil(mark.line);
+                    if (mark.started) {
+                        _rewards.Restart(LineTime(mark.line));
+                    }
+                    _rewardsActive = mark.active;
+                }
+                IssueRewardsUntil(_lineCount);
+            }
+
+            _parsed.clear();
+            _marks.clear();
+        }
+
+        RewardTable<RewardDefinition>::Clock::time_point LineTime(std::uint64_t line) const {
+            return RewardTable<RewardDefinition>::Clock::time_point{} + _options.lineStep * line;
+        }
+
+        // Issues every reward that fell due while the scene was active, up to the given line,
+        // the way the monitor thread's deadline task would.
+        void IssueRewardsUntil(std::uint64_t line) {
+            if (!_rewardsActive || _rewards.Empty()) {
+                return;
+            }
+            auto until = LineTime(line);
+            auto holds = [](RewardCondition) { return true; };
+            for (auto due = _rewards.NextDue(); due <= until; due = _rewards.NextDue()) {
+                if (_rewards.IssueDue(due, holds, [this](const auto& issued) { _issued += issued.size(); }) == 0) {
+                    break;
+                }
+            }
+        }
+
+        struct ParsedLine {
+            std::uint64_t line;
+            OStimLogLine parsed;
+        };
+
+        const Options& _options;
+
+        std::string _arena;
+        std::vector<std::uint32_t> _lines;
+        std::vector<ParsedLine> _parsed;
+        std::vector<SceneMark> _marks;
+
+        OStimLineFilter _filter;
+        SceneStateMachine _state;
+        std::vector<RewardDefinition> _definitions;
+        RewardTable<RewardDefinition> _rewards;
+        bool _rewardsActive = false;
+
+        std::uint64_t _lineCount = 0;
+        std::uint64_t _bytes = 0;
+        std::uint64_t _issued = 0;
+        SceneCounts _counts;
+        EventDigest _digest;
+        unsigned _workers = 0;
+        std::uint64_t _chunks = 0;
+
+        Clock::duration _elapsed{};
+        std::uint64_t _totalAllocations = 0;
+        StageStats _read{"read"};
+        StageStats _parse{"parse"};
+        StageStats _scene{"scene"};
+        StageStats _reward{"rewards"};
+    };
+
+    int PrintUsage() {
+        std::printf("usage: osurvival_replay <OStim.log> [--ini OSurvival-Mode-NG.ini] [--batch lines] "
+                    "[--line-ms ms]\n"
+                    "                       [--parallel workers] [--chunk-bytes bytes] [--verify]\n"
+                    "  --parallel     map the file and parse it on this many threads (0: one per hardware thread)\n"
+                    "  --chunk-bytes  size of the text chunks handed to the parallel workers\n"
+                    "  --verify       replay both sequentially and in parallel and check the results agree\n");
+        return 1;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        return PrintUsage();
+    }
+
+    Options options;
+    options.log = argv[1];
+    bool parallel = false;
+    for (int i = 2; i < argc; i++) {
+        std::string_view arg = argv[i];
+        if (arg == "--verify") {
+            options.verify = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return PrintUsage();
+        }
+        if (arg == "--ini") {
+            options.ini = argv[++i];
+        } else if (arg == "--batch") {
+            long long value = std::atoll(argv[++i]);
+            options.batchLines = value > 0 ? static_cast<std::size_t>(value) : options.batchLines;
+        } else if (arg == "--line-ms") {
+            long long value = std::atoll(argv[++i]);
+            options.lineStep = std::chrono::milliseconds(value > 0 ? value : options.lineStep.count());
+        } else if (arg == "--parallel") {
+            long long value = std::atoll(argv[++i]);
+            options.parallel = value > 0 ? static_cast<unsigned>(value) : 0;
+            parallel = true;
+        } else if (arg == "--chunk-bytes") {
+            long long value = std::atoll(argv[++i]);
+            options.chunkBytes = value > 0 ? static_cast<std::size_t>(value) : options.chunkBytes;
+        } else {
+            return PrintUsage();
+        }
+    }
+
+    if (options.verify) {
+        Replay sequential(options);
+        Replay parallelRun(options);
+        if (!sequential.LoadRewards() || !sequential.Run() || !parallelRun.LoadRewards() ||
+            !parallelRun.RunParallel()) {
+            return 1;
+        }
+        sequential.Report();
+        parallelRun.Report();
+        bool matches = sequential.Matches(parallelRun);
+        std::printf("verify: sequential and parallel replays %s\n", matches ? "match" : "DIFFER");
+        return matches ? 0 : 1;
+    }
+
+    Replay replay(options);
+    if (!replay.LoadRewards() || !(parallel ? replay.RunParallel() : replay.Run())) {
+        return 1;
+    }
+    replay.Report();
+    return 0;
+}